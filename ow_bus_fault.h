@@ -0,0 +1,102 @@
+#ifndef	OW_BUS_FAULT_H__
+#define OW_BUS_FAULT_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_config.h"
+#include "ow_master_hal.h"
+
+// Fault accounting of channel, common for HAL backends. Faults are counted by kind.
+// With OW_FAULT_QUARANTINE, channel with OW_FAULT_QUARANTINE operations in a row started
+// on shorted line is quarantined: packets of channel are skipped by master without bus
+// activity, line is probed by one packet after back-off. Back-off starts from 1 packet
+// and doubles after every failed probe up to OW_FAULT_BACKOFF_MAX packets.
+
+#if (defined (OW_MULTI_CHANNEL))
+#define OW_FAULT_CHANNELS       OW_CHANNEL_COUNT
+#else
+#define OW_FAULT_CHANNELS       1
+#endif
+
+#ifndef OW_FAULT_BACKOFF_MAX
+#define OW_FAULT_BACKOFF_MAX    64      //*< limit of packets skipped between probes      */
+#endif
+
+typedef struct
+{
+	uint16_t count[OWMH_FAULT_COUNT];   //*< faults per kind, saturated                   */
+#ifdef OW_FAULT_QUARANTINE
+	uint8_t  shorts;                    //*< operations in a row started on shorted line  */
+	uint16_t backoff;                   //*< packets skipped before current probe         */
+	uint16_t skip;                      //*< packets left to skip                         */
+#endif
+} ow_bus_fault_t;
+
+static inline void ow_bus_fault_put(ow_bus_fault_t* p_fault, owmh_fault_t fault)
+{
+	if (p_fault->count[fault] < UINT16_MAX)
+		++p_fault->count[fault];
+#ifdef OW_FAULT_QUARANTINE
+	if (fault != OWMH_FAULT_SHORT)
+		return;
+	if (p_fault->shorts < OW_FAULT_QUARANTINE)
+	{
+		if (++p_fault->shorts < OW_FAULT_QUARANTINE)
+			return;
+		p_fault->backoff = 1;
+	}
+	else
+		// failed probe
+		p_fault->backoff = (p_fault->backoff < (OW_FAULT_BACKOFF_MAX / 2)) ? (p_fault->backoff * 2) : OW_FAULT_BACKOFF_MAX;
+	p_fault->skip = p_fault->backoff;
+#endif
+}
+
+// Operation started on released line
+static inline void ow_bus_fault_released(ow_bus_fault_t* p_fault)
+{
+#ifdef OW_FAULT_QUARANTINE
+	p_fault->shorts = 0;
+#endif
+}
+
+static inline bool ow_bus_fault_quarantined(const ow_bus_fault_t* p_fault)
+{
+#ifdef OW_FAULT_QUARANTINE
+	return (p_fault->shorts >= OW_FAULT_QUARANTINE);
+#else
+	return false;
+#endif
+}
+
+#ifdef OW_FAULT_QUARANTINE
+static inline bool ow_bus_fault_skip(ow_bus_fault_t* p_fault)
+{
+	if ((!ow_bus_fault_quarantined(p_fault)) || (p_fault->skip == 0))
+		return false;
+	--p_fault->skip;
+	return true;
+}
+#endif
+
+static inline void ow_bus_fault_stats(ow_bus_fault_t* p_fault, owmh_fault_stats_t* p_stats, bool clear)
+{
+	for (uint8_t k = 0; k < OWMH_FAULT_COUNT; ++k)
+	{
+		p_stats->count[k] = p_fault->count[k];
+		if (clear)
+			p_fault->count[k] = 0;
+	}
+	p_stats->quarantined = ow_bus_fault_quarantined(p_fault);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_BUS_FAULT_H__
@@ -0,0 +1,149 @@
+#ifndef	OW_BUS_GROUP_H__
+#define OW_BUS_GROUP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_config.h"
+
+// Bus groups. Channels are divided into groups, every group has own instance of master
+// and TIMER HAL modules (TIMER, PPI, state and callbacks), so groups transfer concurrently.
+// Group 0 is ow_master.c/ow_master_hal_nrf52.c, group N is the same sources compiled with
+// OW_BUS_GROUP defined (ow_master_groupN.c, ow_master_hal_groupN.c), external names of
+// instance get _gN suffix. Group 0 module routes calls by channel to instances.
+// Channels keep global numbering, group N owns channels from OW_GROUPN_FIRST_CHANNEL.
+
+#ifndef OW_BUS_GROUP_COUNT
+#define OW_BUS_GROUP_COUNT		1
+#endif
+
+#if (OW_BUS_GROUP_COUNT > 1)
+#if (!defined (OW_MULTI_CHANNEL))
+#error "OW_BUS_GROUP_COUNT requires OW_MULTI_CHANNEL"
+#endif
+#if ((defined (OW_HAL_UARTE)) || (defined (OW_HAL_SIM)) || (defined (OW_HAL_DS2482)))
+#error "OW_BUS_GROUP_COUNT is supported by TIMER backend only"
+#endif
+#if (OW_BUS_GROUP_COUNT > 3)
+#error "OW_BUS_GROUP_COUNT: up to 3 groups are supported"
+#endif
+#endif
+
+// group of channel
+#if (OW_BUS_GROUP_COUNT > 2)
+#define OW_GROUP_OF(channel)	(((channel) >= OW_GROUP2_FIRST_CHANNEL) ? 2 : (((channel) >= OW_GROUP1_FIRST_CHANNEL) ? 1 : 0))
+#define OW_GROUP_FUNCTION(group, function)	(((group) == 2) ? function##_g2 : function##_g1)
+#elif (OW_BUS_GROUP_COUNT > 1)
+#define OW_GROUP_OF(channel)	(((channel) >= OW_GROUP1_FIRST_CHANNEL) ? 1 : 0)
+#define OW_GROUP_FUNCTION(group, function)	(function##_g1)
+#else
+#define OW_GROUP_OF(channel)	0
+#endif
+
+// channels of module instance under compilation [OW_GROUP_FIRST_CHANNEL, OW_GROUP_END_CHANNEL)
+#if ((!defined (OW_BUS_GROUP)) || (OW_BUS_GROUP == 0))
+#define OW_GROUP_FIRST_CHANNEL	0
+#if (OW_BUS_GROUP_COUNT > 1)
+#define OW_GROUP_END_CHANNEL	OW_GROUP1_FIRST_CHANNEL
+#endif
+#elif (OW_BUS_GROUP == 1)
+#define OW_GROUP_FIRST_CHANNEL	OW_GROUP1_FIRST_CHANNEL
+#if (OW_BUS_GROUP_COUNT > 2)
+#define OW_GROUP_END_CHANNEL	OW_GROUP2_FIRST_CHANNEL
+#endif
+#elif (OW_BUS_GROUP == 2)
+#define OW_GROUP_FIRST_CHANNEL	OW_GROUP2_FIRST_CHANNEL
+#else
+#error "OW_BUS_GROUP: unknown group"
+#endif
+#ifndef OW_GROUP_END_CHANNEL
+#ifdef OW_MULTI_CHANNEL
+#define OW_GROUP_END_CHANNEL	OW_CHANNEL_COUNT
+#else
+#define OW_GROUP_END_CHANNEL	1
+#endif
+#endif
+
+#if ((OW_BUS_GROUP_COUNT > 1) && ((!defined (OW_BUS_GROUP)) || (OW_BUS_GROUP == 0)))
+// Group 0 module passes calls for channels of other groups to their instances
+#define OW_BUS_GROUP_ROUTER
+#define OW_GROUP_ROUTE(channel, function, args) \
+	if (OW_GROUP_OF(channel) != 0) \
+	{ \
+		OW_GROUP_FUNCTION(OW_GROUP_OF(channel), function) args; \
+		return; \
+	}
+#define OW_GROUP_ROUTE_RETURN(channel, function, args) \
+	if (OW_GROUP_OF(channel) != 0) \
+		return OW_GROUP_FUNCTION(OW_GROUP_OF(channel), function) args;
+#else
+#define OW_GROUP_ROUTE(channel, function, args)
+#define OW_GROUP_ROUTE_RETURN(channel, function, args)
+#endif
+
+#if ((defined (OW_BUS_GROUP)) && (OW_BUS_GROUP > 0))
+// Instance of group: own peripherals and external names
+#undef OW_TIMER_INSTANCE
+#undef OW_COUNTER_TIMER_INSTANCE
+#if (OW_BUS_GROUP == 1)
+#define OW_TIMER_INSTANCE			OW_GROUP1_TIMER_INSTANCE
+#define OW_COUNTER_TIMER_INSTANCE	OW_GROUP1_COUNTER_TIMER_INSTANCE
+#define OW_GROUP_NAME(name)			name##_g1
+#else
+#define OW_TIMER_INSTANCE			OW_GROUP2_TIMER_INSTANCE
+#define OW_COUNTER_TIMER_INSTANCE	OW_GROUP2_COUNTER_TIMER_INSTANCE
+#define OW_GROUP_NAME(name)			name##_g2
+#endif
+
+// ow_master_hal.h
+#define owm_hal_initialize			OW_GROUP_NAME(owm_hal_initialize)
+#define owm_hal_uninitialize		OW_GROUP_NAME(owm_hal_uninitialize)
+#define ow_set_channel				OW_GROUP_NAME(ow_set_channel)
+#define owmh_broadcast				OW_GROUP_NAME(owmh_broadcast)
+#define owmh_ow_change_pins			OW_GROUP_NAME(owmh_ow_change_pins)
+#define owmh_reset					OW_GROUP_NAME(owmh_reset)
+#define owmh_write					OW_GROUP_NAME(owmh_write)
+#define owmh_read					OW_GROUP_NAME(owmh_read)
+#define owmh_triplet				OW_GROUP_NAME(owmh_triplet)
+#define owmh_sequence				OW_GROUP_NAME(owmh_sequence)
+#define owmh_sequence_stage			OW_GROUP_NAME(owmh_sequence_stage)
+#define owmh_rx_crc_check			OW_GROUP_NAME(owmh_rx_crc_check)
+#define owmh_rx_crc_continue		OW_GROUP_NAME(owmh_rx_crc_continue)
+#define owmh_rx_crc8				OW_GROUP_NAME(owmh_rx_crc8)
+#define owmh_wait_flag				OW_GROUP_NAME(owmh_wait_flag)
+#define owmh_delay					OW_GROUP_NAME(owmh_delay)
+#define owmh_hold_power				OW_GROUP_NAME(owmh_hold_power)
+#define owmh_arm_power				OW_GROUP_NAME(owmh_arm_power)
+#define owmh_set_speed				OW_GROUP_NAME(owmh_set_speed)
+#define owmh_set_profile			OW_GROUP_NAME(owmh_set_profile)
+#define owmh_calibrate				OW_GROUP_NAME(owmh_calibrate)
+#define owmh_calibrated				OW_GROUP_NAME(owmh_calibrated)
+#define owmh_isr_count				OW_GROUP_NAME(owmh_isr_count)
+#define owmh_retry_count			OW_GROUP_NAME(owmh_retry_count)
+#define owmh_slot_stats				OW_GROUP_NAME(owmh_slot_stats)
+#define owmh_hot_plug_arm			OW_GROUP_NAME(owmh_hot_plug_arm)
+#define owmh_fault_stats			OW_GROUP_NAME(owmh_fault_stats)
+#define owmh_quarantine_skip		OW_GROUP_NAME(owmh_quarantine_skip)
+#define owmh_active_time_us			OW_GROUP_NAME(owmh_active_time_us)
+// ow_master.h
+#define ow_master_initialize		OW_GROUP_NAME(ow_master_initialize)
+#define ow_master_uninitialize		OW_GROUP_NAME(ow_master_uninitialize)
+#define ow_process_packet			OW_GROUP_NAME(ow_process_packet)
+#define ow_channel_profile_set		OW_GROUP_NAME(ow_channel_profile_set)
+#define ow_channel_calibrate		OW_GROUP_NAME(ow_channel_calibrate)
+#define ow_channel_calibrated		OW_GROUP_NAME(ow_channel_calibrated)
+#define ow_channel_overdrive		OW_GROUP_NAME(ow_channel_overdrive)
+#define ow_channel_slot_stats		OW_GROUP_NAME(ow_channel_slot_stats)
+#define ow_channel_hot_plug_arm		OW_GROUP_NAME(ow_channel_hot_plug_arm)
+#define ow_channel_fault_stats		OW_GROUP_NAME(ow_channel_fault_stats)
+#define crc8						OW_GROUP_NAME(crc8)
+#define docrc8						OW_GROUP_NAME(docrc8)
+#define checkcrc8					OW_GROUP_NAME(checkcrc8)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_BUS_GROUP_H__
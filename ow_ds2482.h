@@ -0,0 +1,132 @@
+#ifndef	OW_DS2482_H__
+#define OW_DS2482_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_config.h"
+
+// DS2482-100/-800 I2C to 1-wire bridge (OW_HAL_DS2482). Timeslots are generated by bridge,
+// HAL backend (ow_master_hal_ds2482.c) issues 1-wire commands and polls status register by
+// asynchronous I2C transfers of port: ow_ds2482_port_nrf52.c (TWIM) on target,
+// ow_sim_ds2482.c (register model over simulated bus) on host.
+
+#ifndef OW_DS2482_ADDRESS
+#define OW_DS2482_ADDRESS       0x18    //*< 7 bit I2C address (AD0..AD2 low)             */
+#endif
+#ifndef OW_TWI_FREQUENCY_KHZ
+#define OW_TWI_FREQUENCY_KHZ    400     //*< I2C clock: 100, 250 or 400 kHz               */
+#endif
+#ifndef OW_DS2482_POLL_LIMIT
+#define OW_DS2482_POLL_LIMIT    64      //*< status readings before bridge is reset       */
+#endif
+#ifndef OW_DS2482_POLL_PAUSE_US
+#define OW_DS2482_POLL_PAUSE_US 200     //*< shorter commands are polled without pause    */
+#endif
+
+// Commands
+#define OW_DS2482_DRST          0xF0    //*< device reset                                 */
+#define OW_DS2482_SRP           0xE1    //*< set read pointer, pointer code follows       */
+#define OW_DS2482_WCFG          0xD2    //*< write configuration                          */
+#define OW_DS2482_CHSL          0xC3    //*< channel select (DS2482-800)                  */
+#define OW_DS2482_1WRS          0xB4    //*< 1-wire reset                                 */
+#define OW_DS2482_1WSB          0x87    //*< 1-wire single bit, bit in MSB of parameter   */
+#define OW_DS2482_1WWB          0xA5    //*< 1-wire write byte                            */
+#define OW_DS2482_1WRB          0x96    //*< 1-wire read byte, result in data register    */
+#define OW_DS2482_1WT           0x78    //*< 1-wire triplet, direction in MSB             */
+
+// Read pointer codes
+#define OW_DS2482_PTR_STATUS    0xF0
+#define OW_DS2482_PTR_DATA      0xE1
+#define OW_DS2482_PTR_CONFIG    0xC3
+#define OW_DS2482_PTR_CHANNEL   0xD2
+
+// Status register
+#define OW_DS2482_STATUS_1WB    0x01    //*< 1-wire busy                                  */
+#define OW_DS2482_STATUS_PPD    0x02    //*< presence pulse detected                      */
+#define OW_DS2482_STATUS_SD     0x04    //*< short detected in reset                      */
+#define OW_DS2482_STATUS_LL     0x08    //*< logic level of line                          */
+#define OW_DS2482_STATUS_RST    0x10    //*< device reset, cleared by WCFG                */
+#define OW_DS2482_STATUS_SBR    0x20    //*< single bit result, first bit of triplet      */
+#define OW_DS2482_STATUS_TSB    0x40    //*< second bit of triplet                        */
+#define OW_DS2482_STATUS_DIR    0x80    //*< direction taken by triplet                   */
+
+// Configuration register. Written with complement in upper nibble, read back without it.
+#define OW_DS2482_CONFIG_APU    0x01    //*< active pull-up                               */
+#define OW_DS2482_CONFIG_SPU    0x04    //*< strong pull-up after next byte or bit write  */
+#define OW_DS2482_CONFIG_1WS    0x08    //*< overdrive speed                              */
+#define OW_DS2482_CONFIG_BYTE(config) ((uint8_t)((config) | (((~(config)) & 0x0F) << 4)))
+
+#define OW_DS2482_CHANNELS      8       //*< channels of DS2482-800                       */
+
+// Bridge timing of 1-wire commands, us (typical, DS2482 data sheet)
+#define OW_DS2482_RESET_US      1148    //*< reset pulse and presence detect cycle        */
+#define OW_DS2482_SLOT_US       70      //*< timeslot with recovery time                  */
+#define OW_DS2482_RESET_OD_US   146     //*< overdrive reset                              */
+#define OW_DS2482_SLOT_OD_US    11      //*< overdrive timeslot                           */
+
+// Channel select codes and their read back values (DS2482-800)
+static const uint8_t ow_ds2482_channel_code[OW_DS2482_CHANNELS] =
+	{0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87};
+static const uint8_t ow_ds2482_channel_readback[OW_DS2482_CHANNELS] =
+	{0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87};
+
+// Duration of I2C transfer, us: address and tx bytes, repeated start, address and rx bytes,
+// 9 clocks per byte, start and stop conditions
+static inline uint32_t ow_ds2482_twi_us(uint8_t tx_length, uint8_t rx_length)
+{
+	uint32_t clocks = 2;
+
+	if (tx_length)
+		clocks += 9 * (1 + (uint32_t)tx_length);
+	if (rx_length)
+		clocks += 1 + 9 * (1 + (uint32_t)rx_length);
+	return (clocks * 1000 + OW_TWI_FREQUENCY_KHZ - 1) / OW_TWI_FREQUENCY_KHZ;
+}
+
+// ------------------------------------ I2C port of bridge -----------------------------------
+
+typedef enum
+{
+	OW_DS2482_PORT_DONE,            //*< transfer completed                           */
+	OW_DS2482_PORT_NACK,            //*< bridge did not acknowledge transfer          */
+	OW_DS2482_PORT_TIMER            //*< timer expired                                */
+} ow_ds2482_port_evt_t;
+
+// Port event handler, invoked in interrupt context
+typedef void(*ow_ds2482_port_handler_t)(ow_ds2482_port_evt_t evt);
+
+/**
+ * @brief Port initialization.
+ *
+ * @param handler  handler of transfer and timer events.
+ */
+void ow_ds2482_port_init(ow_ds2482_port_handler_t handler);
+
+/**
+ * @brief Port uninitialization.
+ */
+void ow_ds2482_port_uninit(void);
+
+/**
+ * @brief Asynchronous transfer to bridge.
+ *
+ * tx_length bytes are written, then rx_length bytes are read after repeated start.
+ * Either length can be 0. Buffers must stay valid until PORT_DONE or PORT_NACK event.
+ */
+void ow_ds2482_port_transfer(uint8_t* p_tx, uint8_t tx_length, uint8_t* p_rx, uint8_t rx_length);
+
+/**
+ * @brief Single shot timer, PORT_TIMER event after delay_us.
+ */
+void ow_ds2482_port_timer(uint32_t delay_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_DS2482_H__
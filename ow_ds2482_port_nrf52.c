@@ -0,0 +1,91 @@
+#include "ow_master_hal.h"
+
+#if ((defined (OW_HAL_DS2482)) && (!defined (OW_DS2482_SIM)))
+
+#include <nrfx_twim.h>
+#include "app_timer.h"
+#include "app_util.h"
+
+#include "app_error.h"
+
+#include "ow_ds2482.h"
+
+// I2C port of DS2482 bridge: nrfx TWIM driver in non-blocking mode and app_timer.
+// app_timer_init() must be called by application.
+
+#if (OW_TWI_FREQUENCY_KHZ == 100)
+#define OW_TWIM_FREQUENCY		NRF_TWIM_FREQ_100K
+#elif (OW_TWI_FREQUENCY_KHZ == 250)
+#define OW_TWIM_FREQUENCY		NRF_TWIM_FREQ_250K
+#elif (OW_TWI_FREQUENCY_KHZ == 400)
+#define OW_TWIM_FREQUENCY		NRF_TWIM_FREQ_400K
+#else
+#error "OW_TWI_FREQUENCY_KHZ: 100, 250 or 400"
+#endif
+
+#define OW_APP_TIMER_TICKS_US(us) \
+	((uint32_t)ROUNDED_DIV((us) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+
+static const nrfx_twim_t ow_twim = NRFX_TWIM_INSTANCE(OW_TWI_INSTANCE);
+
+APP_TIMER_DEF(m_ow_ds2482_timer);
+
+static ow_ds2482_port_handler_t m_handler;
+
+static void ow_twim_event_handler(nrfx_twim_evt_t const * p_event, void * p_context)
+{
+	UNUSED_PARAMETER(p_context);
+	// address or data NACK: bridge is absent or busy
+	m_handler((p_event->type == NRFX_TWIM_EVT_DONE) ? OW_DS2482_PORT_DONE : OW_DS2482_PORT_NACK);
+}
+
+static void ow_ds2482_timer_handler(void * p_context)
+{
+	UNUSED_PARAMETER(p_context);
+	m_handler(OW_DS2482_PORT_TIMER);
+}
+
+void ow_ds2482_port_init(ow_ds2482_port_handler_t handler)
+{
+	nrfx_twim_config_t config = NRFX_TWIM_DEFAULT_CONFIG;
+
+	m_handler = handler;
+	config.scl       = OW_TWI_SCL_PIN;
+	config.sda       = OW_TWI_SDA_PIN;
+	config.frequency = OW_TWIM_FREQUENCY;
+	APP_ERROR_CHECK(nrfx_twim_init(&ow_twim, &config, ow_twim_event_handler, NULL));
+	nrfx_twim_enable(&ow_twim);
+
+	APP_ERROR_CHECK(app_timer_create(&m_ow_ds2482_timer, APP_TIMER_MODE_SINGLE_SHOT, ow_ds2482_timer_handler));
+}
+
+void ow_ds2482_port_uninit(void)
+{
+	nrfx_twim_disable(&ow_twim);
+	nrfx_twim_uninit(&ow_twim);
+}
+
+void ow_ds2482_port_transfer(uint8_t* p_tx, uint8_t tx_length, uint8_t* p_rx, uint8_t rx_length)
+{
+	nrfx_twim_xfer_desc_t xfer;
+
+	// write, then read after repeated start
+	if (rx_length == 0)
+		xfer = (nrfx_twim_xfer_desc_t)NRFX_TWIM_XFER_DESC_TX(OW_DS2482_ADDRESS, p_tx, tx_length);
+	else if (tx_length == 0)
+		xfer = (nrfx_twim_xfer_desc_t)NRFX_TWIM_XFER_DESC_RX(OW_DS2482_ADDRESS, p_rx, rx_length);
+	else
+		xfer = (nrfx_twim_xfer_desc_t)NRFX_TWIM_XFER_DESC_TXRX(OW_DS2482_ADDRESS, p_tx, tx_length, p_rx, rx_length);
+	APP_ERROR_CHECK(nrfx_twim_xfer(&ow_twim, &xfer, 0));
+}
+
+void ow_ds2482_port_timer(uint32_t delay_us)
+{
+	uint32_t ticks = OW_APP_TIMER_TICKS_US(delay_us);
+
+	if (ticks < APP_TIMER_MIN_TIMEOUT_TICKS)
+		ticks = APP_TIMER_MIN_TIMEOUT_TICKS;
+	APP_ERROR_CHECK(app_timer_start(m_ow_ds2482_timer, ticks, NULL));
+}
+
+#endif // ((defined (OW_HAL_DS2482)) && (!defined (OW_DS2482_SIM)))
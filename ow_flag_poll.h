@@ -0,0 +1,91 @@
+#ifndef	OW_FLAG_POLL_H__
+#define OW_FLAG_POLL_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_config.h"
+
+// Predictive polling of ready flag. Device is expected to complete operation at
+// OW_FLAG_EXPECTED_PERCENT of time-out given in wait flag procedure. Flag is read once
+// at start, then HAL sleeps until dense polling window around expected time, polls flag every
+// OW_FLAG_POLL_MIN_US within window, and after window doubles poll interval up to
+// OW_FLAG_POLL_MAX_US until time-out.
+
+#ifndef OW_FLAG_EXPECTED_PERCENT
+#define OW_FLAG_EXPECTED_PERCENT    80      //*< expected completion time, % of time-out      */
+#endif
+#ifndef OW_FLAG_DENSE_WINDOW_US
+#define OW_FLAG_DENSE_WINDOW_US     8000    //*< half-width of dense polling window           */
+#endif
+#ifndef OW_FLAG_POLL_MIN_US
+#define OW_FLAG_POLL_MIN_US         250     //*< poll interval in dense window                */
+#endif
+#ifndef OW_FLAG_POLL_MAX_US
+#define OW_FLAG_POLL_MAX_US         8000    //*< poll interval limit of backoff after window  */
+#endif
+
+typedef struct
+{
+	uint32_t elapsed_us;      //*< time since start of wait flag procedure      */
+	uint32_t timeout_us;
+	uint32_t dense_start_us;  //*< dense polling window                         */
+	uint32_t dense_end_us;
+	uint32_t interval_us;     //*< current backoff interval                     */
+} ow_flag_poll_t;
+
+static inline void ow_flag_poll_init(ow_flag_poll_t* p_poll, uint16_t max_wait_ms)
+{
+	uint32_t expected_us = (uint32_t)max_wait_ms * 10 * OW_FLAG_EXPECTED_PERCENT;
+
+	p_poll->elapsed_us     = 0;
+	p_poll->timeout_us     = (uint32_t)max_wait_ms * 1000;
+	p_poll->dense_start_us = (expected_us > OW_FLAG_DENSE_WINDOW_US) ? (expected_us - OW_FLAG_DENSE_WINDOW_US) : 0;
+	p_poll->dense_end_us   = expected_us + OW_FLAG_DENSE_WINDOW_US;
+	p_poll->interval_us    = OW_FLAG_POLL_MIN_US;
+}
+
+/**
+ * @brief Pause before next flag reading.
+ *
+ * @param slot_us  duration of flag reading timeslot, accounted in elapsed time.
+ *
+ * @return pause in microseconds, 0 - time-out reached.
+ */
+static inline uint32_t ow_flag_poll_next(ow_flag_poll_t* p_poll, uint32_t slot_us)
+{
+	uint32_t pause;
+
+	p_poll->elapsed_us += slot_us;
+	if (p_poll->elapsed_us >= p_poll->timeout_us)
+		return 0;
+
+	if (p_poll->elapsed_us < p_poll->dense_start_us)
+		pause = p_poll->dense_start_us - p_poll->elapsed_us;   // sleep until window
+	else if (p_poll->elapsed_us < p_poll->dense_end_us)
+		pause = OW_FLAG_POLL_MIN_US;
+	else
+	{
+		pause = p_poll->interval_us;
+		p_poll->interval_us = (p_poll->interval_us < (OW_FLAG_POLL_MAX_US / 2)) ? (p_poll->interval_us * 2) : OW_FLAG_POLL_MAX_US;
+	}
+
+	// last reading at time-out
+	if (pause > (p_poll->timeout_us - p_poll->elapsed_us))
+		pause = p_poll->timeout_us - p_poll->elapsed_us;
+	if (pause < OW_FLAG_POLL_MIN_US)
+		pause = OW_FLAG_POLL_MIN_US;
+
+	p_poll->elapsed_us += pause;
+	return pause;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_FLAG_POLL_H__
@@ -26,13 +26,14 @@ typedef enum
 	OWMM_STATE_BUSY                       //*< Busy. i-wire packet under processing.               */
 } owmm_state_t;
 
-static owmm_state_t		  m_manager_state = OWMM_STATE_NOT_INITIALIZED;
+// Every bus group has own state and queue, groups process packets concurrently
+static owmm_state_t		  m_manager_state[OW_BUS_GROUP_COUNT];   // OWMM_STATE_NOT_INITIALIZED
 
 static uint16_t           fifo_size_mask; /**< Read/write index mask. Also used for size checking. */
-static volatile uint32_t  fifo_read_pos;  /**< Next read position in the FIFO buffer.              */
-static volatile uint32_t  fifo_write_pos; /**< Next write position in the FIFO buffer.             */
+static volatile uint32_t  fifo_read_pos[OW_BUS_GROUP_COUNT];  /**< Next read position in the FIFO buffer.  */
+static volatile uint32_t  fifo_write_pos[OW_BUS_GROUP_COUNT]; /**< Next write position in the FIFO buffer. */
 
-static ow_packet_t*		  fifo_buf[OW_MANAGER_FIFO_SIZE];
+static ow_packet_t*		  fifo_buf[OW_BUS_GROUP_COUNT][OW_MANAGER_FIFO_SIZE];
 
 // forward declaration
 static void ow_manager_callback(ow_result_t  result, ow_packet_t* p_ow_packet);
@@ -45,10 +46,12 @@ void ow_manager_initialize(void)
 	
 	CHECK_ERROR_BOOL(_IS_POWER_OF_TWO(OW_MANAGER_FIFO_SIZE));
 	fifo_size_mask     = OW_MANAGER_FIFO_SIZE - 1;
-	fifo_read_pos      = 0;
-	fifo_write_pos     = 0;
-
-	m_manager_state = OWMM_STATE_IDLE;
+	for (uint8_t group = 0; group < OW_BUS_GROUP_COUNT; ++group)
+	{
+		fifo_read_pos[group]   = 0;
+		fifo_write_pos[group]  = 0;
+		m_manager_state[group] = OWMM_STATE_IDLE;
+	}
 }
 
 // module deinitialization
@@ -56,11 +59,15 @@ void ow_manager_initialize(void)
 uint32_t ow_manager_uninitialize(void)
 {
 	uint32_t result = 1;
+	bool     idle = true;
 	
 	_CRITICAL_REGION_ENTER();
-	if((m_manager_state == OWMM_STATE_IDLE)&&(ow_master_uninitialize() == 0))
+	for (uint8_t group = 0; group < OW_BUS_GROUP_COUNT; ++group)
+		idle &= (m_manager_state[group] == OWMM_STATE_IDLE);
+	if((idle)&&(ow_master_uninitialize() == 0))
 	{
-		m_manager_state = OWMM_STATE_NOT_INITIALIZED;
+		for (uint8_t group = 0; group < OW_BUS_GROUP_COUNT; ++group)
+			m_manager_state[group] = OWMM_STATE_NOT_INITIALIZED;
 		result = 0;
 	}
 	_CRITICAL_REGION_EXIT();
@@ -68,40 +75,41 @@ uint32_t ow_manager_uninitialize(void)
 }
 
 // utility function for fifo buffer handling
-static __INLINE uint32_t fifo_length(void)
+static __INLINE uint32_t fifo_length(uint8_t group)
 {
-	if (fifo_write_pos < fifo_read_pos)
-		return (fifo_write_pos + ~fifo_read_pos + 1);	
+	if (fifo_write_pos[group] < fifo_read_pos[group])
+		return (fifo_write_pos[group] + ~fifo_read_pos[group] + 1);	
 	else
-		return (fifo_write_pos - fifo_read_pos);
+		return (fifo_write_pos[group] - fifo_read_pos[group]);
 }
 
 // Put packet into queue if other packet already under processing. if not, process directly.
 void ow_enqueue_packet(ow_packet_t* p_ow_packet)
 {
-	CHECK_ERROR_BOOL(m_manager_state != OWMM_STATE_NOT_INITIALIZED);
+	uint8_t group = OW_GROUP_OF(p_ow_packet->channel);
+	CHECK_ERROR_BOOL(m_manager_state[group] != OWMM_STATE_NOT_INITIALIZED);
 	
 	bool	buffer_overflow	= false;
 	bool	launch_packet	= false;
 	
 	// thread safe buffer handling in critical section	
 	_CRITICAL_REGION_ENTER();
-	if(m_manager_state == OWMM_STATE_IDLE)
+	if(m_manager_state[group] == OWMM_STATE_IDLE)
 	{
 		// manager in idle, buffer is empty. Pass packet for processing directly
-		m_manager_state = OWMM_STATE_BUSY;
+		m_manager_state[group] = OWMM_STATE_BUSY;
 		launch_packet = true;
 	}
 	else
 	{
 		// check buffer overflow
-		if (fifo_length() > fifo_size_mask)
+		if (fifo_length(group) > fifo_size_mask)
 			buffer_overflow = true;
 		else 
 		{
 			// put packet into buffer
-			fifo_buf[fifo_write_pos&fifo_size_mask] = p_ow_packet;
-			++fifo_write_pos;			
+			fifo_buf[group][fifo_write_pos[group]&fifo_size_mask] = p_ow_packet;
+			++fifo_write_pos[group];			
 		}
 	}
 	_CRITICAL_REGION_EXIT();
@@ -115,25 +123,32 @@ void ow_enqueue_packet(ow_packet_t* p_ow_packet)
 void ow_manager_callback(ow_result_t  result, ow_packet_t* p_ow_packet)
 {
 	ow_packet_t*		p_next_packet  = NULL;
+	// group is taken before packet callback, it can change channel of packet
+	uint8_t				group = OW_GROUP_OF(p_ow_packet->channel);
+	bool				repeat;
 	
 	// invoke packet callback if defined. If not 0 returned, send packet for processing again
-	if ((p_ow_packet->callback)&&(p_ow_packet->callback(result, p_ow_packet) != 0))
+	repeat = ((p_ow_packet->callback)&&(p_ow_packet->callback(result, p_ow_packet) != 0));
+	if ((repeat)&&(OW_GROUP_OF(p_ow_packet->channel) == group))
 	{
 		ow_process_packet(p_ow_packet);
 	}
 	else
 	{
+		// packet moved to channel of other bus group is queued there
+		if (repeat)
+			ow_enqueue_packet(p_ow_packet);
 		// thread safe buffer handling in critical section 
 		_CRITICAL_REGION_ENTER();
-		if(fifo_write_pos != fifo_read_pos)
+		if(fifo_write_pos[group] != fifo_read_pos[group])
 		{
 			// buffer is not empty. Take next packet
-			p_next_packet	 = fifo_buf[fifo_read_pos&fifo_size_mask];
-			++fifo_read_pos;
+			p_next_packet	 = fifo_buf[group][fifo_read_pos[group]&fifo_size_mask];
+			++fifo_read_pos[group];
 		}
 		else
 			// buffer is empty. Go to idle state.
-			m_manager_state = OWMM_STATE_IDLE;	
+			m_manager_state[group] = OWMM_STATE_IDLE;	
 		_CRITICAL_REGION_EXIT();
 		// after leaving of critical section send packet for processing
 		if(p_next_packet)
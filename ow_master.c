@@ -22,9 +22,7 @@ typedef enum
 	OWM_STATE_ROM,                   //*< transmitting 8 bytes of ROM address                     */     
 	OWM_STATE_DATA,                  //*< transmitting and reseaving data bits                    */  
 #ifdef OW_ROM_SEARCH_SUPPORT
-	OWM_STATE_SEARCH_POLL0,          //*< reading first bit of complement pair in search process  */
-	OWM_STATE_SEARCH_POLL1,          //*< reading second bit of complement pair in search process */
-	OWM_STATE_SEARCH_DIR,            //*< writing direction bit  in search process                */
+	OWM_STATE_SEARCH_TRIPLET,        //*< complement pair reading and direction writing in search */
 #endif
 	OWM_STATE_WAIT_FLAG,             //*< reading until '1' readed or time-out riached            */
 	OWM_STATE_DELAY,
@@ -38,6 +36,35 @@ static owm_state_t   m_ow_master_state = OWM_STATE_NOT_INITIALIZED;  //*< 1-wire
 static ow_packet_t*  m_p_ow_packet;       //*< ptr to 1-wire packet under processing              */
 
 static ow_master_callback_t  m_callback;  //*< callback after packet processed                    */
+#ifdef OW_SLOT_RETRY
+static uint8_t               m_slot_retries; //*< restarts of packet under processing             */
+#endif
+#ifdef OW_DATA_SEGMENTS
+static uint8_t               m_segment_index; //*< next data segment of packet                    */
+static bool                  m_segment_crc;   //*< CRC8 checking was armed for reseived data      */
+#endif
+#ifdef OW_HAL_STAGING
+static bool                  m_staged;        //*< next phase is staged in HAL                    */
+#endif
+
+#if (defined (OW_MULTI_CHANNEL))
+#define OWM_CHANNEL(p_packet)  ((p_packet)->channel)
+#else
+#define OWM_CHANNEL(p_packet)  0
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+// Devices switched to overdrive. Packets of RESUME command or with overdrive_speed are
+// transferred at overdrive speed until no response on overdrive reset. Standard speed
+// reset of other packets returns all devices of channel from overdrive.
+#if (defined (OW_MULTI_CHANNEL))
+static bool m_overdrive[OW_CHANNEL_COUNT];
+#define OWM_OVERDRIVE  m_overdrive[m_p_ow_packet->channel]
+#else
+static bool m_overdrive;
+#define OWM_OVERDRIVE  m_overdrive
+#endif
+#endif
 
 // Default callback. Used if no other registered. 
 static void owm_default_callback(ow_result_t  result, ow_packet_t* p_packet)
@@ -63,11 +90,26 @@ void ow_master_initialize(ow_master_callback_t callback)
 	
 	owm_hal_initialize(owm_on_hal_op_completed);
 	m_ow_master_state = OWM_STATE_IDLE;
+#ifdef OW_BUS_GROUP_ROUTER
+	// masters of other bus groups report to the same callback
+	ow_master_initialize_g1(callback);
+#if (OW_BUS_GROUP_COUNT > 2)
+	ow_master_initialize_g2(callback);
+#endif
+#endif
 }
 
 //1-Wire master driver uninitialization.
 uint32_t ow_master_uninitialize()
 {
+#ifdef OW_BUS_GROUP_ROUTER
+	if (ow_master_uninitialize_g1() != 0)
+		return 1;
+#if (OW_BUS_GROUP_COUNT > 2)
+	if (ow_master_uninitialize_g2() != 0)
+		return 1;
+#endif
+#endif
 	if ((m_ow_master_state == OWM_STATE_IDLE)&&(owm_hal_uninitialize() == 0))
 	{
 		m_ow_master_state = OWM_STATE_NOT_INITIALIZED;
@@ -77,36 +119,333 @@ uint32_t ow_master_uninitialize()
 		return 1;
 }
 
+#ifdef OW_HAL_STAGING
+// Staging of data phase. Segmented data and data followed by strong pull-up
+// are started by master.
+static bool ow_packet_data_stage(void)
+{
+#ifdef OW_DATA_SEGMENTS
+	if (m_p_ow_packet->data.p_segments)
+		return false;
+#endif
+	if ((m_p_ow_packet->data.tx_count == 0) && (m_p_ow_packet->data.rx_count == 0))
+		return false;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	if ((m_p_ow_packet->delay_ms > 0) && (m_p_ow_packet->hold_power) &&
+		(m_p_ow_packet->data.tx_count > 0) && (m_p_ow_packet->data.rx_count == 0))
+		return false;
+#endif
+	owmh_sequence_stage(m_p_ow_packet->data.p_txbuf,
+		m_p_ow_packet->data.p_rxbuf,
+		m_p_ow_packet->data.tx_count,
+		m_p_ow_packet->data.rx_count);
+#ifdef OW_RX_CRC8
+	owmh_rx_crc_check(m_p_ow_packet->data.rx_crc_check);
+#endif
+	return true;
+}
+
+// Staging of phase following current one, HAL starts it on successful completion
+// of current phase. Phases with bus speed switching and search triplets are not staged.
+static void ow_packet_stage(void)
+{
+	m_staged = false;
+	switch (m_ow_master_state)
+	{
+	case OWM_STATE_RESET:
+		owmh_sequence_stage(&m_p_ow_packet->ROM_command, NULL, 8, 0);
+		break;
+	case OWM_STATE_COMMAND:
+		if (m_p_ow_packet->ROM_command == OWM_CMD_READ)
+		{
+			owmh_sequence_stage(NULL, (uint8_t*)(m_p_ow_packet->p_ROM_code), 0, 64);
+#ifdef OW_RX_CRC8
+			owmh_rx_crc_check(8);
+#endif
+		}
+		else if (m_p_ow_packet->ROM_command == OWM_CMD_MATCH)
+			owmh_sequence_stage((uint8_t*)(m_p_ow_packet->p_ROM_code), NULL, 64, 0);
+		else if (((m_p_ow_packet->ROM_command != OWM_CMD_SKIP) &&
+				(m_p_ow_packet->ROM_command != OWM_CMD_RESUME)) || (!ow_packet_data_stage()))
+			return;
+		break;
+	case OWM_STATE_ROM:
+		if (!ow_packet_data_stage())
+			return;
+		break;
+	default:
+		return;
+	}
+	m_staged = true;
+}
+
+// Phase started by HAL from staging. Phase following it is staged. Returns false,
+// if phase was not staged.
+static bool ow_packet_staged(owm_state_t state)
+{
+	if (!m_staged)
+		return false;
+	m_ow_master_state = state;
+	ow_packet_stage();
+	return true;
+}
+#define OWM_STAGE()         ow_packet_stage()
+#define OWM_STAGED(state)   ow_packet_staged(state)
+#else
+#define OWM_STAGE()         ((void)0)
+#define OWM_STAGED(state)   false
+#endif
+
+// Packet transfer from reset
+static void ow_packet_start(void)
+{
+	m_ow_master_state = OWM_STATE_RESET;
+#ifdef OW_OVERDRIVE_SUPPORT
+	// overdrive ROM commands are transmitted after standard speed reset, as other ROM
+	// commands addressing devices of standard speed, if overdrive speed is not requested
+	if ((m_p_ow_packet->ROM_command == OWM_CMD_OVERDRIVE)
+			|| (m_p_ow_packet->ROM_command == OWM_CMD_MATCH_OVERDRIVE)
+			|| ((!m_p_ow_packet->overdrive_speed) && (m_p_ow_packet->ROM_command != OWM_CMD_RESUME)))
+		OWM_OVERDRIVE = false;
+	owmh_set_speed(OWM_OVERDRIVE);
+#endif
+	// ROM command is started by HAL after presence pulse
+	OWM_STAGE();
+	// Call HAL primitive
+	owmh_reset();
+}
+
 // Processing 1-wire packet
 void ow_process_packet(ow_packet_t* p_ow_packet)
 {
+	// packets of other bus groups are processed by their masters concurrently
+	OW_GROUP_ROUTE(p_ow_packet->channel, ow_process_packet, (p_ow_packet));
 	// Check, if previos process completed
 	CHECK_ERROR_BOOL(m_ow_master_state == OWM_STATE_IDLE);
+	// Initialise common parameters
+	m_p_ow_packet = p_ow_packet;
+#ifdef OW_FAULT_QUARANTINE
+	// line of quarantined channel is not touched until next probe. HAL reports
+	// skipped packet from interrupt as failed reset, as any other completion
+	m_ow_master_state = OWM_STATE_RESET;
+#ifdef OW_BROADCAST
+	if ((p_ow_packet->channel_mask == 0) && (owmh_quarantine_skip(OWM_CHANNEL(p_ow_packet))))
+#else
+	if (owmh_quarantine_skip(OWM_CHANNEL(p_ow_packet)))
+#endif
+		return;
+#endif
 	// Set channal
 #if (defined (OW_MULTI_CHANNEL))
 	ow_set_channel(p_ow_packet->channel);
 #endif
-	// Initialise common parameters
-	m_p_ow_packet = p_ow_packet;
-	m_ow_master_state = OWM_STATE_RESET;
-	// Call HAL primitive
-	owmh_reset();
+#ifdef OW_BROADCAST
+	if (p_ow_packet->channel_mask)
+	{
+		// writing packet is transferred on all channels of mask at once, at standard speed
+		CHECK_ERROR_BOOL((p_ow_packet->channel_mask & (1 << p_ow_packet->channel)) != 0);
+		CHECK_ERROR_BOOL((p_ow_packet->ROM_command == OWM_CMD_SKIP) || (p_ow_packet->ROM_command == OWM_CMD_MATCH));
+		CHECK_ERROR_BOOL(!p_ow_packet->wait_flag);
+#ifdef OW_DATA_SEGMENTS
+		if (p_ow_packet->data.p_segments)
+		{
+			for (uint8_t k = 0; k < p_ow_packet->data.segment_count; ++k)
+				CHECK_ERROR_BOOL(!p_ow_packet->data.p_segments[k].rx);
+		}
+		else
+#endif
+		CHECK_ERROR_BOOL(p_ow_packet->data.rx_count == 0);
+#ifdef OW_OVERDRIVE_SUPPORT
+		for (uint8_t k = 0; k < OW_CHANNEL_COUNT; ++k)
+		{
+			if (p_ow_packet->channel_mask & (1 << k))
+				m_overdrive[k] = false;
+		}
+#endif
+		owmh_broadcast(p_ow_packet->channel_mask);
+	}
+#endif
+#ifdef OW_SLOT_RETRY
+	m_slot_retries = 0;
+#endif
+	ow_packet_start();
+}
+
+// Timing profile of channel
+void ow_channel_profile_set(uint8_t channel, owmh_profile_t profile)
+{
+	OW_GROUP_ROUTE(channel, ow_channel_profile_set, (channel, profile));
+	owmh_set_profile(channel, profile);
 }
 
+#ifdef OW_BUS_CALIBRATION
+// Bus calibration of channel
+void ow_channel_calibrate(uint8_t channel)
+{
+	OW_GROUP_ROUTE(channel, ow_channel_calibrate, (channel));
+	owmh_calibrate(channel);
+}
+
+bool ow_channel_calibrated(uint8_t channel)
+{
+	OW_GROUP_ROUTE_RETURN(channel, ow_channel_calibrated, (channel));
+	return owmh_calibrated(channel);
+}
+#endif
+
+#ifdef OW_SLOT_HISTOGRAM
+// Slot timing statistics of channel
+void ow_channel_slot_stats(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear)
+{
+	OW_GROUP_ROUTE(channel, ow_channel_slot_stats, (channel, p_stats, clear));
+	owmh_slot_stats(channel, p_stats, clear);
+}
+#endif
+
+#ifdef OW_BUS_FAULTS
+// Fault statistics of channel
+void ow_channel_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear)
+{
+	OW_GROUP_ROUTE(channel, ow_channel_fault_stats, (channel, p_stats, clear));
+	owmh_fault_stats(channel, p_stats, clear);
+}
+#endif
+
+#ifdef OW_HOT_PLUG
+// Hot-plug detection on channel
+void ow_channel_hot_plug_arm(uint8_t channel, owmh_hot_plug_handler_t handler)
+{
+	OW_GROUP_ROUTE(channel, ow_channel_hot_plug_arm, (channel, handler));
+	owmh_hot_plug_arm(channel, handler);
+}
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+// Overdrive state of channel
+bool ow_channel_overdrive(uint8_t channel)
+{
+#if (defined (OW_MULTI_CHANNEL))
+	CHECK_ERROR_BOOL(channel < OW_CHANNEL_COUNT);
+	OW_GROUP_ROUTE_RETURN(channel, ow_channel_overdrive, (channel));
+	return m_overdrive[channel];
+#else
+	return m_overdrive;
+#endif
+}
+#endif
+
 // Utility function
 static void ow_packet_terminate(ow_result_t result)
 {
+#ifdef OW_BROADCAST
+	// channels reached by broadcast packet are left in mask
+	if (m_p_ow_packet->channel_mask)
+		m_p_ow_packet->channel_mask = owmh_broadcast(0);
+#endif
 	m_ow_master_state = OWM_STATE_IDLE;
 	m_callback(result, (void*)m_p_ow_packet);
 }
 
+#ifdef OW_DATA_SEGMENTS
+// Transfer of next data segments. Transmitted segment followed by reseived one is
+// transferred by one HAL sequence. Returns false, if no segments left.
+static bool ow_packet_segment_transfer(void)
+{
+	ow_segment_t* p_segment;
+	uint8_t*      p_txbuf  = NULL;
+	uint8_t*      p_rxbuf  = NULL;
+	uint16_t      tx_count = 0;
+	uint16_t      rx_count = 0;
+
+	if (m_segment_index >= m_p_ow_packet->data.segment_count)
+		return false;
+	p_segment = &m_p_ow_packet->data.p_segments[m_segment_index];
+	if (!p_segment->rx)
+	{
+		p_txbuf  = p_segment->p_buf;
+		tx_count = p_segment->count;
+		++p_segment;
+		++m_segment_index;
+	}
+	if ((m_segment_index < m_p_ow_packet->data.segment_count) && (p_segment->rx))
+	{
+		p_rxbuf  = p_segment->p_buf;
+		rx_count = p_segment->count;
+		++m_segment_index;
+	}
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	// pull-up after last transmitted segment
+	if ((m_p_ow_packet->delay_ms > 0) && (m_p_ow_packet->hold_power) && (tx_count > 0) &&
+		(rx_count == 0) && (m_segment_index == m_p_ow_packet->data.segment_count))
+		owmh_arm_power();
+#endif
+#ifdef OW_RX_CRC8
+	// rx_crc_check bytes are counted from first reseived segment, CRC8 runs over next ones
+	if (m_segment_crc)
+		owmh_rx_crc_continue();
+	else if (rx_count > 0)
+	{
+		owmh_rx_crc_check(m_p_ow_packet->data.rx_crc_check);
+		m_segment_crc = true;
+	}
+#endif
+	owmh_sequence(p_txbuf, p_rxbuf, tx_count, rx_count);
+	return true;
+}
+#endif
+
+// Transfer of packet data. If data is a command followed by strong pull-up,
+// HAL engages pull-up immediately after last bit.
+static void ow_packet_data_transfer(void)
+{
+	m_ow_master_state = OWM_STATE_DATA;
+#ifdef OW_DATA_SEGMENTS
+	if (m_p_ow_packet->data.p_segments)
+	{
+		CHECK_ERROR_BOOL(m_p_ow_packet->data.segment_count > 0);
+		m_segment_index = 0;
+		m_segment_crc   = false;
+		ow_packet_segment_transfer();
+		return;
+	}
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	if ((m_p_ow_packet->delay_ms > 0) && (m_p_ow_packet->hold_power) &&
+		(m_p_ow_packet->data.tx_count > 0) && (m_p_ow_packet->data.rx_count == 0))
+		owmh_arm_power();
+#endif
+#ifdef OW_RX_CRC8
+	owmh_rx_crc_check(m_p_ow_packet->data.rx_crc_check);
+#endif
+	owmh_sequence(m_p_ow_packet->data.p_txbuf,
+		m_p_ow_packet->data.p_rxbuf, 
+		m_p_ow_packet->data.tx_count,
+		m_p_ow_packet->data.rx_count);
+}
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+// Search triplet for next bit of search route. Direction at discrepancy:
+// 1 at last discrepancy, bit of previous route before it, 0 after it.
+static void ow_search_triplet(uint8_t bit_number, uint8_t byte_index, uint8_t byte_mask)
+{
+	uint8_t direction = 0;
+
+	if (bit_number == m_p_ow_packet->search.last_discrepancy)
+		direction = 1;
+	else if (bit_number < m_p_ow_packet->search.last_discrepancy)
+		direction = ((m_p_ow_packet->p_ROM_code->raw[byte_index] & byte_mask) != 0);
+
+	m_ow_master_state = OWM_STATE_SEARCH_TRIPLET;
+	owmh_triplet(direction);
+}
+#endif
+
 // 1-Wire master driver state machine procedure.
 // Invoking as callback after completion of 1-wire HAL operation
 static void owm_on_hal_op_completed(owmh_callback_result_t result)
 {
 #ifdef OW_ROM_SEARCH_SUPPORT
 	// variables for searching process
-	static uint8_t poll_bit_0;
 	static uint8_t crc8;
 	static uint8_t bit_number;
 	static uint8_t byte_index;
@@ -115,6 +454,18 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 	static uint8_t last_family_zero;
 	static uint8_t direction_bit;
 	bool critical_consistency_error;
+#endif
+#ifdef OW_SLOT_RETRY
+	if (result == OWMHCR_SLOT_LATE)
+	{
+		// slot was stretched by preemption, devices could get wrong bit. Packet is restarted
+		if (m_slot_retries++ < OW_SLOT_RETRY)
+		{
+			ow_packet_start();
+			return;
+		}
+		result = OWMHCR_ERROR;
+	}
 #endif
 	switch (m_ow_master_state)
 	{
@@ -124,9 +475,22 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 		if (result == OWMHCR_RESET_OK)
 		{
 			// set COMMAND state, transfer 1 WIRE ROM COMMAND
+			if (OWM_STAGED(OWM_STATE_COMMAND))
+				break;
 			m_ow_master_state = OWM_STATE_COMMAND;
 			owmh_sequence(&m_p_ow_packet->ROM_command, NULL, 8, 0);
+			OWM_STAGE();
+		}
+#ifdef OW_OVERDRIVE_SUPPORT
+		else if ((result == OWMHCR_RESET_NO_RESPONCE) && (OWM_OVERDRIVE))
+		{
+			// devices dropped out of overdrive. Repeat reset at standard speed
+			OWM_OVERDRIVE = false;
+			owmh_set_speed(false);
+			OWM_STAGE();
+			owmh_reset();
 		}
+#endif
 		else if (result == OWMHCR_RESET_NO_RESPONCE)
 			// no devices on bus
 			ow_packet_terminate(OWMR_NO_RESPONSE);
@@ -143,29 +507,47 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 	case OWM_STATE_COMMAND:
 		if (result == OWMHCR_SEQUENCE_OK)
 		{
+			// ROM address or data phase is already started by HAL
+			if (OWM_STAGED((m_p_ow_packet->ROM_command == OWM_CMD_MATCH) ? OWM_STATE_ROM : OWM_STATE_DATA))
+				break;
 			// prepare and transfer packet depanding on ROM command
 			switch (m_p_ow_packet->ROM_command)
 			{
 			case OWM_CMD_READ:
 				// read 8 bit ROM adress
 				m_ow_master_state = OWM_STATE_DATA;
+#ifdef OW_RX_CRC8
+				// ROM address ends with its CRC8
+				owmh_rx_crc_check(8);
+#endif
 				owmh_sequence(NULL, (uint8_t*)(m_p_ow_packet->p_ROM_code), 0, 64);
 				break;
 		
+#ifdef OW_OVERDRIVE_SUPPORT
+			case OWM_CMD_OVERDRIVE:
+				// devices switched to overdrive after command byte
+				OWM_OVERDRIVE = true;
+				owmh_set_speed(true);
+				// no break. Data transferred as in SKIP ROM
+#endif
 			case OWM_CMD_SKIP:
 			case OWM_CMD_RESUME:
 				// skip ROM address transmitting. Send data immediately
-				m_ow_master_state = OWM_STATE_DATA;
-				owmh_sequence(m_p_ow_packet->data.p_txbuf,
-					m_p_ow_packet->data.p_rxbuf, 
-					m_p_ow_packet->data.tx_count,
-					m_p_ow_packet->data.rx_count);
-					break;
+				ow_packet_data_transfer();
+				break;
 		
+#ifdef OW_OVERDRIVE_SUPPORT
+			case OWM_CMD_MATCH_OVERDRIVE:
+				// ROM address transferred at overdrive speed
+				OWM_OVERDRIVE = true;
+				owmh_set_speed(true);
+				// no break
+#endif
 			case OWM_CMD_MATCH:
 				// transfer 8 bit ROM address
 				m_ow_master_state = OWM_STATE_ROM;
 				owmh_sequence((uint8_t*)(m_p_ow_packet->p_ROM_code), NULL, 64, 0);
+				OWM_STAGE();
 				break;
 		
 #ifdef OW_ROM_SEARCH_SUPPORT
@@ -184,9 +566,8 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 					last_zero  = 0;
 					last_family_zero  = 0;
 					m_p_ow_packet->search.consistency_fault = false;
-					// polling of direct and complement bits at next position (first in this case) 
-					m_ow_master_state = OWM_STATE_SEARCH_POLL0;
-					owmh_read();
+					// polling of direct and complement bits and direction writing at first position
+					ow_search_triplet(bit_number, byte_index, byte_mask);
 				}
 				break;
 #endif
@@ -209,12 +590,9 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 		if (result == OWMHCR_SEQUENCE_OK)
 		{
 			// transfer data
-			m_ow_master_state = OWM_STATE_DATA;
-			owmh_sequence(m_p_ow_packet->data.p_txbuf,
-				m_p_ow_packet->data.p_rxbuf, 
-				m_p_ow_packet->data.tx_count,
-				m_p_ow_packet->data.rx_count);
-}
+			if (!OWM_STAGED(OWM_STATE_DATA))
+				ow_packet_data_transfer();
+		}
 		else if (result == OWMHCR_ERROR)
 			// incorrect signal timing on bus
 			ow_packet_terminate(OWMR_COMMUNICATION_ERROR);
@@ -236,6 +614,17 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 				break;
 			case OWM_CMD_SKIP:
 			case OWM_CMD_MATCH:
+#ifdef OW_OVERDRIVE_SUPPORT
+			case OWM_CMD_OVERDRIVE:
+			case OWM_CMD_MATCH_OVERDRIVE:
+#endif
+#ifdef OW_RX_CRC8
+				m_p_ow_packet->data.rx_crc8 = owmh_rx_crc8();
+#endif
+#ifdef OW_DATA_SEGMENTS
+				if ((m_p_ow_packet->data.p_segments) && (ow_packet_segment_transfer()))
+					break;
+#endif
 				// finalizing procedures - wate flag, hold power, delay
 				if(m_p_ow_packet->delay_ms > 0)
 				{
@@ -269,6 +658,11 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 				HANDLE_ERROR();
 			}
 		}
+#ifdef OW_RX_CRC8
+		else if (result == OWMHCR_CRC_ERROR)
+			// reading aborted on wrong CRC8 of checked bytes
+			ow_packet_terminate(OWMR_COMMUNICATION_ERROR);
+#endif
 		else if (result == OWMHCR_ERROR)
 			// incorrect signal timing on bus
 			ow_packet_terminate(OWMR_COMMUNICATION_ERROR);
@@ -323,147 +717,103 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 		break;
 #ifdef OW_ROM_SEARCH_SUPPORT
 //----------------------------------------------------------------------------------------------------------------	
-// polling complement bits in searching process - first bit readed   
-	case OWM_STATE_SEARCH_POLL0 :
-		if(result <= OWMHCR_READ_1)
+// search triplet completed: direct and complement bits are read, direction bit is written   
+	case OWM_STATE_SEARCH_TRIPLET :
+		if (result == OWMHCR_ERROR)
 		{
-			poll_bit_0 = result;
-			m_ow_master_state = OWM_STATE_SEARCH_POLL1;
-			owmh_read();
-		}
-		else if (result == OWMHCR_ERROR)
 			// incorrect signal timing on bus
 			ow_packet_terminate(OWMR_COMMUNICATION_ERROR);
-		else
+			break;
+		}
+		if ((result & (~OWMH_TRIPLET_MASK)) != OWMHCR_TRIPLET)
+		{
 			// common logic error
 			HANDLE_ERROR();
-		break;
-//----------------------------------------------------------------------------------------------------------------	
-// polling complement bits in searching process - second bit readed   
-	case OWM_STATE_SEARCH_POLL1 :
+			break;
+		}
 		critical_consistency_error = false;
+		direction_bit = ((result & OWMH_TRIPLET_DIR) != 0);
 
-		if (result == OWMHCR_READ_1)
+		switch (result & (OWMH_TRIPLET_ID | OWMH_TRIPLET_CMP))
 		{
-			if (poll_bit_0 == 1)
+		case (OWMH_TRIPLET_ID | OWMH_TRIPLET_CMP):
+			// poll bits 1 1 (3)
+			if((bit_number == 1)&&(m_p_ow_packet->ROM_command == OWM_CMD_ALARM_SEARCH))
 			{
-				// poll bits 1 1 (3)
-				if((bit_number == 1)&&(m_p_ow_packet->ROM_command == OWM_CMD_ALARM_SEARCH))
-					// No response at first polling in alarm searching 
-					ow_packet_terminate(OWMR_NOT_FOUND);   //OWMR_NO_ALARMED_DEVICES
-				else
-				{
-					// No response at any other cases. Wrong situation. Termination of search route
-					m_p_ow_packet->search.consistency_fault = true;
-					critical_consistency_error = true;
-					//ow_packet_terminate(OWMR_SEARCH_CONSISTENCY_FAULT);
-					break;
-				}
+				// No response at first polling in alarm searching 
+				ow_packet_terminate(OWMR_NOT_FOUND);   //OWMR_NO_ALARMED_DEVICES
+				return;
 			}
-			else
+			// No response at any other cases. Wrong situation. Termination of search route
+			m_p_ow_packet->search.consistency_fault = true;
+			critical_consistency_error = true;
+			break;
+
+		case OWMH_TRIPLET_CMP:
+			// poll bits 1 0 (2)
+			// No discrepancy. Direction = polling bit, but check concistency
+			if (((byte_mask & m_p_ow_packet->p_ROM_code->raw[byte_index]) == 1) 
+				                 && (bit_number < m_p_ow_packet->search.last_discrepancy)) // broken consistency
 			{
-				// poll bits 1 0 (2)
-				// No discrepancy. Direction = polling bit, but check concistency
-				direction_bit = 0;
-				if (((byte_mask & m_p_ow_packet->p_ROM_code->raw[byte_index]) == 1) 
-					                 && (bit_number < m_p_ow_packet->search.last_discrepancy)) // broken consistency
-				{
-					m_p_ow_packet->search.consistency_fault = true;
-					critical_consistency_error = true;
-					//m_p_ow_packet->result = OWMR_SEARCH_CONSISTENCY_FAULT;
-				}
+				m_p_ow_packet->search.consistency_fault = true;
+				critical_consistency_error = true;
 			}
-		}
-		else if (result == OWMHCR_READ_0)
-		{
-			if (poll_bit_0 == 1)
+			break;
+
+		case OWMH_TRIPLET_ID:
+			// poll bits 0 1 (1)
+			// No discrepancy. Direction = polling bit, but check concistency
+			if (((byte_mask & m_p_ow_packet->p_ROM_code->raw[byte_index]) == 0) 
+				                 && (bit_number < m_p_ow_packet->search.last_discrepancy)) // broken consistency
 			{
-				// poll bits 0 1 (1)
-				// No discrepancy. Direction = polling bit, but check concistency
-				direction_bit = 1;
-				if (((byte_mask & m_p_ow_packet->p_ROM_code->raw[byte_index]) == 0) 
-					                 && (bit_number < m_p_ow_packet->search.last_discrepancy)) // broken consistency
-				{
-					m_p_ow_packet->search.consistency_fault = true;
-					m_p_ow_packet->search.last_discrepancy = bit_number;    // Reset last_discrepancy to current position
-				}
+				m_p_ow_packet->search.consistency_fault = true;
+				m_p_ow_packet->search.last_discrepancy = bit_number;    // Reset last_discrepancy to current position
 			}
-			else
+			break;
+
+		default:
+			// poll bits 0 0 (0)
+			// Discrepancy detected. Direction is chosen by HAL from hint of ow_search_triplet()
+			if (!direction_bit)
 			{
-				// poll bits 0 0 (0)
-				// Discrepancy detected.
-				if(bit_number == m_p_ow_packet->search.last_discrepancy)
-				{
-					// Last discrepancy position. Direction = 1	
-					direction_bit = 1;
-				} 
-				else if(bit_number < m_p_ow_packet->search.last_discrepancy)
-				{
-					// Index less than last discrepancy. Get direction from saved ROM					
-					direction_bit = byte_mask & m_p_ow_packet->p_ROM_code->raw[byte_index];
-				} 
-				else
-				{
-					// Index after last discrepancy. Direction = 0				
-					direction_bit = 0;
-				}
-				if (!direction_bit)
-				{
-					last_zero = bit_number;   // Save last turn to direction 0
-					if(!byte_index)
-						last_family_zero = bit_number;  // Save last turn to direction 0 in device family code (first byte in ROM)
-				}
+				last_zero = bit_number;   // Save last turn to direction 0
+				if(!byte_index)
+					last_family_zero = bit_number;  // Save last turn to direction 0 in device family code (first byte in ROM)
 			}
 		}
-		else
-		{
-			// common logic error
-			HANDLE_ERROR();
-			break;
-		} 
 
 		if (critical_consistency_error) // Termination of search route
-			ow_packet_terminate(OWMR_SEARCH_CONSISTENCY_FAULT);
-		else // normal workflow
 		{
-			// Save direction in ROM
-			if(direction_bit)
-				m_p_ow_packet->p_ROM_code->raw[byte_index] |= byte_mask;   // Set bit in ROM
-			else
-				m_p_ow_packet->p_ROM_code->raw[byte_index] &= (~byte_mask);   // Clear bit in ROM
-			
-			// Transmit direction bit
-			m_ow_master_state = OWM_STATE_SEARCH_DIR;
-			owmh_write(direction_bit);
-		
-			// Last bit in byte
-			if(byte_mask == 0x80)
-			{
-				// Calculate and save CRC
-				docrc8(&crc8, m_p_ow_packet->p_ROM_code->raw[byte_index]);
-				// Reset mask, shift byte index
-				byte_mask = 0x01;
-				++byte_index;
-			}
-			else 
-				byte_mask <<= 1;  // Shift mask
+			ow_packet_terminate(OWMR_SEARCH_CONSISTENCY_FAULT);
+			break;
+		}
 
-			// Shift bit index, check, if rout is ended
-			if(++bit_number > 64)
-			{
-				// Search rout is ended
-				m_p_ow_packet->search.last_family_discrepancy = last_family_zero;
-				m_p_ow_packet->search.last_discrepancy = last_zero;
-				if(last_zero  == 0) // Last device address was routed                                                                                                                                            
-					m_p_ow_packet->search.last_device = true;
-			}
+		// Save direction in ROM
+		if(direction_bit)
+			m_p_ow_packet->p_ROM_code->raw[byte_index] |= byte_mask;   // Set bit in ROM
+		else
+			m_p_ow_packet->p_ROM_code->raw[byte_index] &= (~byte_mask);   // Clear bit in ROM
+			
+		// Last bit in byte
+		if(byte_mask == 0x80)
+		{
+			// Calculate and save CRC
+			docrc8(&crc8, m_p_ow_packet->p_ROM_code->raw[byte_index]);
+			// Reset mask, shift byte index
+			byte_mask = 0x01;
+			++byte_index;
 		}
-		break;
-//----------------------------------------------------------------------------------------------------------------	
-// after sending next bit of ROM address in searching process   
-	case OWM_STATE_SEARCH_DIR :
-		if(bit_number > 64) // all bits are routed
+		else 
+			byte_mask <<= 1;  // Shift mask
+
+		// Shift bit index, check, if rout is ended
+		if(++bit_number > 64)
 		{
+			// Search rout is ended
+			m_p_ow_packet->search.last_family_discrepancy = last_family_zero;
+			m_p_ow_packet->search.last_discrepancy = last_zero;
+			if(last_zero  == 0) // Last device address was routed                                                                                                                                            
+				m_p_ow_packet->search.last_device = true;
 			// Check CRC
 			if(crc8 != 0)
 				// Wrong CRC
@@ -473,11 +823,8 @@ static void owm_on_hal_op_completed(owmh_callback_result_t result)
 				ow_packet_terminate(OWMR_SUCCESS);
 		}
 		else
-		{
 			// Poll next complement bits
-			m_ow_master_state = OWM_STATE_SEARCH_POLL0;
-			owmh_read();
-		}
+			ow_search_triplet(bit_number, byte_index, byte_mask);
 		break;
 		//----------------------------------------------------------------------------------------------------------------	
 #endif
@@ -7,6 +7,7 @@ extern "C" {
 
 #include "ow_config.h"	
 #include "ow_packet.h"	
+#include "ow_master_hal.h"	
 	
 // 1-wire master callback function. Registering by higher level module, invoking after 
 // transfer completion. Result of operation and ptr to packet passes in callback parameters. 
@@ -43,6 +44,130 @@ uint32_t ow_master_uninitialize();
  */
 void ow_process_packet(ow_packet_t* p_ow_packet);
 
+/**
+ * @brief Timing profile of channel
+ * 
+ * Slot timing of channel adjusted to bus length. Applied from next packet of the channel.
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param profile  timing profile.
+ */
+void ow_channel_profile_set(uint8_t channel, owmh_profile_t profile);
+
+#ifdef OW_BUS_CALIBRATION
+/**
+ * @brief Bus calibration of channel
+ * 
+ * Timing is derived from statistics of previous transfers and applied from next packet
+ * of the channel. If statistics is not enough, channel keeps its profile timing.
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ */
+void ow_channel_calibrate(uint8_t channel);
+
+/**
+ * @brief Calibration state of channel
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ *
+ * @retval true  calibrated timing is used on channel.
+ * @retval false profile timing is used (not calibrated or fall back after errors).
+ */
+bool ow_channel_calibrated(uint8_t channel);
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+/**
+ * @brief Overdrive state of channel
+ * 
+ * @param channel  1-wire channel (ignored in single channel configuration).
+ *
+ * @retval true  devices of channel were switched to overdrive by last transfers.
+ * @retval false channel works at standard speed.
+ */
+bool ow_channel_overdrive(uint8_t channel);
+#endif
+
+#ifdef OW_SLOT_HISTOGRAM
+/**
+ * @brief Slot timing statistics of channel
+ * 
+ * Histograms of captured edges and number of read edges close to read bounds.
+ * Drift of edges toward bounds shows degrading cable run before errors rise.
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param p_stats  statistics copy.
+ * @param clear    if true, statistics of channel is cleared after copying.
+ */
+void ow_channel_slot_stats(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear);
+#endif
+
+#ifdef OW_BUS_FAULTS
+/**
+ * @brief Fault statistics of channel
+ * 
+ * Failed operations counted by kind: shorted line, line not released after slot,
+ * presence pulse out of window, edge timing and late interrupts. Quarantine state
+ * of channel, if OW_FAULT_QUARANTINE is defined: packets of quarantined channel
+ * complete with OWMR_COMMUNICATION_ERROR without bus activity, except probes.
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param p_stats  statistics copy.
+ * @param clear    if true, counters of channel are cleared after copying.
+ */
+void ow_channel_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear);
+#endif
+
+#ifdef OW_HOT_PLUG
+/**
+ * @brief Hot-plug detection on channel
+ * 
+ * Presence pulse of device attached to idle channel invokes handler (interrupt context),
+ * so application can search the channel that changed instead of sweeping all channels.
+ * Detection is single shot, channel is armed again after handling. Event is a hint,
+ * devices of channel are confirmed by search.
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param handler  handler invoked with channel number.
+ */
+void ow_channel_hot_plug_arm(uint8_t channel, owmh_hot_plug_handler_t handler);
+#endif
+
+#ifdef OW_BUS_GROUP_ROUTER
+// master instances of other bus groups (ow_master_group1.c, ow_master_group2.c)
+#define OW_GROUP_MASTER_DECLARE(suffix) \
+	void ow_master_initialize##suffix(ow_master_callback_t callback); \
+	uint32_t ow_master_uninitialize##suffix(void); \
+	void ow_process_packet##suffix(ow_packet_t* p_ow_packet); \
+	void ow_channel_profile_set##suffix(uint8_t channel, owmh_profile_t profile); \
+	void ow_channel_calibrate##suffix(uint8_t channel); \
+	bool ow_channel_calibrated##suffix(uint8_t channel); \
+	bool ow_channel_overdrive##suffix(uint8_t channel);
+
+OW_GROUP_MASTER_DECLARE(_g1)
+#if (OW_BUS_GROUP_COUNT > 2)
+OW_GROUP_MASTER_DECLARE(_g2)
+#endif
+#ifdef OW_SLOT_HISTOGRAM
+void ow_channel_slot_stats_g1(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear);
+#if (OW_BUS_GROUP_COUNT > 2)
+void ow_channel_slot_stats_g2(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear);
+#endif
+#endif
+#ifdef OW_BUS_FAULTS
+void ow_channel_fault_stats_g1(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear);
+#if (OW_BUS_GROUP_COUNT > 2)
+void ow_channel_fault_stats_g2(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear);
+#endif
+#endif
+#ifdef OW_HOT_PLUG
+void ow_channel_hot_plug_arm_g1(uint8_t channel, owmh_hot_plug_handler_t handler);
+#if (OW_BUS_GROUP_COUNT > 2)
+void ow_channel_hot_plug_arm_g2(uint8_t channel, owmh_hot_plug_handler_t handler);
+#endif
+#endif
+#endif
+
 // crc8 utility functions.
 uint8_t crc8(uint8_t crc, uint8_t value);
 void docrc8(uint8_t* crc, uint8_t value);
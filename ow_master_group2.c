@@ -0,0 +1,7 @@
+// Master instance of bus group 2 (see ow_bus_group.h)
+#include "ow_config.h"
+
+#if ((defined (OW_BUS_GROUP_COUNT)) && (OW_BUS_GROUP_COUNT > 2))
+#define OW_BUS_GROUP 2
+#include "ow_master.c"
+#endif
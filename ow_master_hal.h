@@ -10,6 +10,46 @@ extern "C" {
 #endif
 	
 #include "ow_config.h"	
+#include "ow_bus_group.h"
+
+// HAL backend selection. Only one backend may be chosen in ow_config.h,
+// TIMER/PPI/GPIOTE backend (ow_master_hal_nrf52.c) is used by default.
+// OW_HAL_SIM - simulated bus for host builds (ow_master_hal_sim.c, ow_sim.h).
+// OW_HAL_DS2482 - DS2482-100/-800 I2C bridge (ow_master_hal_ds2482.c, ow_ds2482.h).
+#if (((defined (OW_HAL_UARTE)) && (defined (OW_HAL_SIM))) || \
+     ((defined (OW_HAL_DS2482)) && ((defined (OW_HAL_UARTE)) || (defined (OW_HAL_SIM)))))
+#error "Only one HAL backend may be chosen"
+#endif
+#if ((defined (OW_HAL_UARTE)) || (defined (OW_HAL_SIM)) || (defined (OW_HAL_DS2482)))
+#define OW_HAL_BACKEND_SELECTED
+#endif
+#if (!defined (OW_HAL_BACKEND_SELECTED))
+#define OW_HAL_TIMER
+#endif
+#if ((defined (OW_BROADCAST)) && (!defined (OW_HAL_TIMER)))
+#error "OW_BROADCAST is supported by TIMER backend only"
+#endif
+#if ((defined (OW_SLOT_RETRY)) && (!defined (OW_HAL_TIMER)))
+#error "OW_SLOT_RETRY is supported by TIMER backend only"
+#endif
+#if ((defined (OW_SLOT_HISTOGRAM)) && (!defined (OW_HAL_TIMER)))
+#error "OW_SLOT_HISTOGRAM is supported by TIMER backend only"
+#endif
+#if ((defined (OW_TRACE)) && (!defined (OW_HAL_TIMER)))
+#error "OW_TRACE is supported by TIMER backend only"
+#endif
+#if ((defined (OW_HOT_PLUG)) && (defined (OW_HAL_UARTE)))
+#error "OW_HOT_PLUG is not supported by UARTE backend"
+#endif
+#if ((defined (OW_HOT_PLUG)) && (defined (OW_HAL_DS2482)))
+#error "OW_HOT_PLUG is not supported by DS2482 backend"
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HAL_DS2482)) && (!defined (OW_HW_STRONG_PULLUP)))
+#error "DS2482 backend engages strong pull-up by OW_HW_STRONG_PULLUP only"
+#endif
+#if ((defined (OW_FAULT_QUARANTINE)) && (!defined (OW_BUS_FAULTS)))
+#error "OW_FAULT_QUARANTINE requires OW_BUS_FAULTS"
+#endif
 	
 /**
  * Result of 1 WIRE HAL operation, passing in callback parameter
@@ -29,9 +69,84 @@ typedef enum
 	OWMHCR_FLAG_OK,              /**< ready flag read before time-out reached                */
 	OWMHCR_TIME_OUT,             /**< ready flag not read before time-out reached            */
 	
-	OWMHCR_ERROR                 /**< incorrect signal timing on bus was detected            */
+	OWMHCR_ERROR,                /**< incorrect signal timing on bus was detected            */
+	OWMHCR_SLOT_LATE,            /**< strobe of slot was preempted, slot can be corrupted    */
+	OWMHCR_CRC_ERROR,            /**< CRC8 of checked received bytes is wrong, read aborted  */
+
+	OWMHCR_TRIPLET    = 0x10     /**< search triplet completed, OWMH_TRIPLET_* bits added    */
 } owmh_callback_result_t;
 
+// Bits of search triplet result (OWMHCR_TRIPLET | bits)
+#define OWMH_TRIPLET_ID      0x01    /**< direct bit read                                        */
+#define OWMH_TRIPLET_CMP     0x02    /**< complement bit read                                    */
+#define OWMH_TRIPLET_DIR     0x04    /**< direction bit written                                  */
+#define OWMH_TRIPLET_MASK    0x07
+
+#if (defined (OW_SLOT_HISTOGRAM))
+/**
+ * Kind of captured edge in slot histogram
+ */
+typedef enum
+{
+	OWMH_HIST_WRITE0 = 0,        /**< line rise after write 0 pulse, 1 us per bin            */
+	OWMH_HIST_WRITE1,            /**< line rise after write 1 pulse, 1 us per bin            */
+	OWMH_HIST_READ0,             /**< release of line by device from strobe, 4 us per bin    */
+	OWMH_HIST_READ1,             /**< line rise after read pulse, 1 us per bin               */
+	OWMH_HIST_PRESENCE,          /**< end of presence pulse from end of reset, 16 us per bin */
+	
+	OWMH_HIST_COUNT
+} owmh_hist_t;
+
+#define OWMH_HIST_BINS       16      /**< last bin collects all longer edges                     */
+
+/**
+ * Timing statistics of channel. Counters are saturated.
+ */
+typedef struct
+{
+	uint16_t bins[OWMH_HIST_COUNT][OWMH_HIST_BINS]; /**< captured edges per kind and bin      */
+	uint16_t near_read1;         /**< read 1 edges closer than margin to read 1 bound        */
+	uint16_t near_read0;         /**< read 0 edges closer than margin to read 0 bound        */
+} owmh_slot_stats_t;
+#endif
+
+#if (defined (OW_BUS_FAULTS))
+/**
+ * Kind of bus fault
+ */
+typedef enum
+{
+	OWMH_FAULT_SHORT = 0,        /**< line is low at start of operation (stuck low, shorted) */
+	OWMH_FAULT_NO_RELEASE,       /**< line is not released at end of slot                    */
+	OWMH_FAULT_PRESENCE,         /**< edge of reset slot out of presence window              */
+	OWMH_FAULT_TIMING,           /**< edge of data slot out of its window                    */
+	OWMH_FAULT_LATE,             /**< slot stretched by late interrupt (OW_SLOT_RETRY)       */
+	
+	OWMH_FAULT_COUNT
+} owmh_fault_t;
+
+/**
+ * Fault statistics of channel. Counters are saturated.
+ */
+typedef struct
+{
+	uint16_t count[OWMH_FAULT_COUNT]; /**< faults per kind                                   */
+	bool     quarantined;        /**< channel is quarantined (OW_FAULT_QUARANTINE)           */
+} owmh_fault_stats_t;
+#endif
+
+/**
+ * Timing profile of 1-wire channel
+ */
+typedef enum
+{
+	OWMH_PROFILE_STANDARD = 0,   /**< default timing                                         */
+	OWMH_PROFILE_FAST,           /**< short bus, minimal recovery times                      */
+	OWMH_PROFILE_LONG_LINE,      /**< long cable, slow edges and extended recovery times     */
+	
+	OWMH_PROFILE_COUNT
+} owmh_profile_t;
+
 // --------------------------------------------------------------------------------------------
 
 // 1-wire master HAL callback function. Registering by ow_master module, invoking after 
@@ -64,6 +179,22 @@ uint32_t owm_hal_uninitialize(void);
 void ow_set_channel(uint8_t channel);
 #endif
 
+#if (defined (OW_BROADCAST))
+/**
+ * @brief Broadcast channel set establishing.
+ *
+ * Subsequent reset, writing sequences, delays and hold power are driven on all channels
+ * of mask at once by one timer, presence and edges are captured per channel. Channels
+ * without presence pulse or with incorrect timing are dropped from set, operation fails
+ * only if no channel left. Timing profile of channel set by ow_set_channel() is used.
+ *
+ * @param channel_mask  bit per channel of bus group, 0 - return to single channel.
+ *
+ * @return channels of previous set, which completed all operations.
+ */
+uint8_t owmh_broadcast(uint8_t channel_mask);
+#endif
+
 // -------------------------------- 1-WIRE HAL primitives --------------------------------------
 
 /**
@@ -94,14 +225,72 @@ void owmh_write(uint8_t bit);
  */
 void owmh_read(void);
 
+#if (defined (OW_ROM_SEARCH_SUPPORT))
+/**
+ * @brief ROM search triplet primitive.
+ *
+ * Direct and complement bits are read, then direction bit is written: read bit if they differ,
+ * direction parameter if both are 0 (discrepancy), 1 if both are 1 (no devices).
+ * If success, callback parameter = OWMHCR_TRIPLET | OWMH_TRIPLET_* bits.
+ * If incorrect timing on bus detected, callback parameter = OWMHCR_ERROR
+ */
+void owmh_triplet(uint8_t direction);
+#endif
+
 /**
  * @brief Continuous 1-wire transfer.
  *
  * Transmitting tx_count bits from txdata, then resiving rx_count bits to rxdata 
+ * (up to 65535 bits in total, so whole device memory can be streamed after one reset).
  * If success, result in callback parameter OWMHCR_SEQUENCE_OK
  * If errors are detected, callback parameter = OWMHCR_ERROR
  */
-void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint8_t  tx_count, uint8_t  rx_count);
+void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count);
+
+#if (defined (OW_HAL_STAGING))
+/**
+ * @brief Staging of next sequence.
+ *
+ * Sequence is started by HAL from completion interrupt of current operation, if it is
+ * successful (OWMHCR_RESET_OK or OWMHCR_SEQUENCE_OK), then callback is invoked for
+ * completed operation. Other results drop staged sequence. Sequence staged in idle state
+ * follows next started operation. CRC8 checking armed after staging applies to staged
+ * sequence. Only one sequence can be staged, tx_count + rx_count must not be 0.
+ */
+void owmh_sequence_stage(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count);
+#endif
+
+#if (defined (OW_RX_CRC8))
+/**
+ * @brief Received data CRC8 checking arming.
+ *
+ * Dallas CRC8 of bytes received by every sequence is maintained byte by byte in interrupts.
+ * If check_count is not 0, CRC8 of first check_count received bytes of next sequence (data
+ * with trailing CRC byte) must be 0. Otherwise reading is aborted on the last checked byte,
+ * and callback parameter = OWMHCR_CRC_ERROR.
+ *
+ * @param check_count  number of bytes to check, 0 - no checking.
+*/
+void owmh_rx_crc_check(uint8_t check_count);
+
+/**
+ * @brief Received data CRC8 continuation.
+ *
+ * CRC8 of next sequence is not reset, it continues from CRC8 of last sequence together
+ * with bytes left to check. Data split into several sequences (data segments) is checked
+ * as one block, received parts must end on byte boundary.
+*/
+void owmh_rx_crc_continue(void);
+
+/**
+ * @brief CRC8 of bytes received by last sequence.
+ *
+ * Valid in callback of OWMHCR_SEQUENCE_OK. Bits of incomplete last byte are not included.
+ * CRC8 of data with trailing CRC byte is 0, so after checked bytes CRC8 covers rest of data.
+ * After owmh_rx_crc_continue() CRC8 covers continued sequences.
+*/
+uint8_t owmh_rx_crc8(void);
+#endif
 
 /**
  * @brief Waiting for ready flag. 
@@ -137,6 +326,150 @@ void owmh_delay(uint16_t delay_ms);
  * @param delay_ms  duration in microseconds.
 */
 void owmh_hold_power(uint16_t delay_ms);
+
+#if (defined (OW_HW_STRONG_PULLUP))
+/**
+ * @brief Strong pull-up arming.
+ *
+ * Strong pull-up is engaged by hardware at end of last write slot of next
+ * sequence, without CPU involvement. Only write sequences are armed, owmh_hold_power
+ * must follow the sequence, it keeps already engaged pull-up.
+*/
+void owmh_arm_power(void);
+#endif
+#endif
+
+/**
+ * @brief Timing profile selection.
+ *
+ * Profile of channel is applied from next reset on the channel.
+ * Overdrive timing does not depend on profile.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param profile  timing profile.
+*/
+void owmh_set_profile(uint8_t channel, owmh_profile_t profile);
+
+#if (defined (OW_BUS_CALIBRATION))
+/**
+ * @brief Bus calibration request.
+ *
+ * Slot timing of channel is derived on next reset from edges captured in previous
+ * transfers (line rise time, release of line by devices, end of presence pulse).
+ * Channel returns to its profile, if errors rise in calibrated timing.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+*/
+void owmh_calibrate(uint8_t channel);
+
+/**
+ * @brief Calibrated timing state.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ *
+ * @retval true  calibrated timing is used on channel.
+*/
+bool owmh_calibrated(uint8_t channel);
+#endif
+
+#if (defined (OW_OVERDRIVE_SUPPORT))
+/**
+ * @brief Bus speed selection.
+ *
+ * Sets timing of subsequent operations. Devices are switched to overdrive
+ * by OVERDRIVE ROM commands and returned by standard speed reset.
+ * 
+ * @param overdrive  if true, overdrive timing used, else standard.
+*/
+void owmh_set_speed(bool overdrive);
+#endif
+
+#if (defined (OW_SLOT_HISTOGRAM))
+/**
+ * @brief Slot timing statistics of channel.
+ *
+ * Edges of successful standard speed timeslots are accumulated per channel.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param p_stats  statistics copy.
+ * @param clear    if true, statistics of channel is cleared after copying.
+*/
+void owmh_slot_stats(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear);
+#endif
+
+#if (defined (OW_BUS_FAULTS))
+/**
+ * @brief Fault statistics of channel.
+ *
+ * Failed operations are classified by state of line and captured edges.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param p_stats  statistics copy.
+ * @param clear    if true, counters of channel are cleared after copying.
+*/
+void owmh_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear);
+
+#if (defined (OW_FAULT_QUARANTINE))
+/**
+ * @brief Quarantine check of channel.
+ *
+ * Channel is quarantined after OW_FAULT_QUARANTINE operations in a row started on
+ * shorted line. Packets of quarantined channel are skipped, one packet probes the line
+ * after back-off, back-off doubles after every failed probe. Operation started on
+ * released line lifts quarantine.
+ * Skipped packet is reported as operation: callback parameter OWMHCR_ERROR is passed
+ * from interrupt context without bus activity, so packets are not completed
+ * recursively from caller of master.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ *
+ * @retval true  packet is skipped, it is counted in back-off. HAL is busy until callback.
+*/
+bool owmh_quarantine_skip(uint8_t channel);
+#endif
+#endif
+
+#if (defined (OW_HOT_PLUG))
+// Hot-plug handler. Invoked in interrupt context with channel of detected bus activity.
+typedef void(*owmh_hot_plug_handler_t)(uint8_t channel);
+
+/**
+ * @brief Hot-plug detection arming.
+ *
+ * Rising edge on line of channel out of transfer (end of presence pulse of attached
+ * device) invokes handler once, then detection on the channel is disarmed until
+ * next arming. Handler is stored per channel.
+ * 
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param handler  hot-plug handler.
+*/
+void owmh_hot_plug_arm(uint8_t channel, owmh_hot_plug_handler_t handler);
+#endif
+
+#if (defined (OW_SLOT_RETRY))
+/**
+ * @brief Number of late timeslots since start.
+ *
+ * Slots with strobe stretched by preemption: re-issued reset and flag reading
+ * slots and slots reported by OWMHCR_SLOT_LATE.
+*/
+uint32_t owmh_retry_count(void);
+#endif
+
+#if (defined (OW_HAL_ISR_COUNTER))
+/**
+ * @brief Number of HAL interrupts serviced since start.
+ *
+ * Diagnostic counter for comparison of HAL modes and backends.
+*/
+uint32_t owmh_isr_count(void);
+
+/**
+ * @brief Active time of HAL since start, microseconds.
+ *
+ * Time of HFCLK dependent peripherals running (TIMER, UARTE or TWIM transfers).
+*/
+uint32_t owmh_active_time_us(void);
 #endif
 
 #ifdef __cplusplus
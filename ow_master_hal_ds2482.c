@@ -0,0 +1,878 @@
+#include "ow_master_hal.h"
+
+#ifdef OW_HAL_DS2482
+
+#include "app_util_platform.h"
+#include "app_error.h"
+
+#include "ow_ds2482.h"
+#ifdef OW_PREDICTIVE_FLAG_POLL
+#include "ow_flag_poll.h"
+#endif
+#ifdef OW_RX_CRC8
+#include "ow_packet.h"
+#endif
+#ifdef OW_BUS_FAULTS
+#include "ow_bus_fault.h"
+#endif
+
+// DS2482 bridge HAL backend. Every HAL operation is a chain of I2C transfers to bridge:
+// 1-wire command is written and status register is read in one transfer, status is polled
+// until 1-wire busy bit is cleared. Whole bytes of sequence are transferred by 1WWB/1WRB,
+// rest of bits and single slots by 1WSB, search steps by 1WT. Channel selection (DS2482-800)
+// and configuration are written lazily before command which needs them. Bridge is reset
+// at start and after every I2C failure.
+
+// OW master HAL states
+typedef enum
+{
+	OWMHS_IDLE,
+
+	OWMHS_RESET,
+	OWMHS_READ,
+	OWMHS_WRITE,
+#ifdef OW_ROM_SEARCH_SUPPORT
+	OWMHS_TRIPLET,
+#endif
+
+	OWMHS_SEQUENCE,
+
+	OWMHS_READ_FLAG,
+	OWMHS_FLAG_PAUSE,
+	OWMHS_DELAY,
+#ifdef OW_PARASITE_POWER_SUPPORT
+	OWMHS_POWER_HOLD,
+#endif
+#ifdef OW_FAULT_QUARANTINE
+	OWMHS_SKIP,                    // packet of quarantined channel, no bus activity
+#endif
+
+	OWMHS_NOT_INITIALIZED
+} owmh_state_t;
+
+// I2C transfer in progress
+typedef enum
+{
+	OWMH_STEP_DEVICE_RESET,    // DRST, status read back
+	OWMH_STEP_CHANNEL,         // CHSL, channel code read back
+	OWMH_STEP_CONFIG,          // WCFG, configuration read back
+	OWMH_STEP_STATUS,          // 1-wire command or status pointer set, status read
+	OWMH_STEP_DATA,            // data register read after 1WRB
+	OWMH_STEP_POLL_PAUSE,      // port timer before status polling
+	OWMH_STEP_PAUSE            // port timer of operation
+} owmh_step_t;
+
+#define OW_FLAG_PAUSE_MS		1
+
+#ifdef OW_PREDICTIVE_FLAG_POLL
+// flag reading duration, us. Lower bound (command and status transfer), so that
+// last reading is not earlier than time-out
+#define OW_FLAG_SLOT_US			ow_ds2482_twi_us(2, 1)
+static ow_flag_poll_t m_flag_poll;
+#endif
+
+#define OW_DS2482_INVALID		0xFF     // configuration or channel is not known
+
+#ifdef OW_MULTI_CHANNEL
+#ifndef OW_DS2482_800
+#error "OW_MULTI_CHANNEL requires DS2482-800 bridge (OW_DS2482_800)"
+#endif
+#if (OW_CHANNEL_COUNT > OW_DS2482_CHANNELS)
+#error "DS2482-800 has 8 channels"
+#endif
+#define OW_DS2482_CHANNEL_COUNT	OW_CHANNEL_COUNT
+#else
+#define OW_DS2482_CHANNEL_COUNT	1
+#endif
+
+static owmh_callback_t  m_callback;
+
+static volatile owmh_state_t m_state = OWMHS_NOT_INITIALIZED;
+static owmh_step_t      m_step;
+static uint8_t          m_polls;          // status readings of current command
+static uint32_t         m_poll_pause_us;  // pause before polling of current command
+static bool             m_bridge_reset;   // bridge is reset before next operation
+static uint8_t          m_config;         // configuration of next command
+static uint8_t          m_config_written = OW_DS2482_INVALID;
+static uint8_t          m_channel;
+static uint8_t          m_channel_selected = OW_DS2482_INVALID;
+static owmh_profile_t   m_profile[OW_DS2482_CHANNEL_COUNT];
+static uint8_t          m_bit;            // written bit or triplet direction
+
+static uint8_t*         m_p_tx_buf;
+static uint8_t*         m_p_rx_buf;
+static uint16_t         m_tx_count;
+static uint16_t         m_slot_count;     // total number of timeslots in sequence
+static uint16_t         m_slot_index;     // first timeslot of command under processing
+static uint8_t          m_slots;          // timeslots of command: 8 (byte) or 1 (bit)
+static uint16_t         m_delay_counter;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+static bool             m_pullup_armed;   // pull-up armed for next sequence
+static bool             m_pullup_hw;      // strong pull-up follows last write command
+#endif
+
+// I2C buffers. Must be placed in RAM.
+static uint8_t          m_twi_tx[2];
+static uint8_t          m_twi_rx;
+
+#ifdef OW_HAL_ISR_COUNTER
+static uint32_t   m_isr_count;
+static uint32_t   m_twi_us;        // duration of I2C transfers, not 1-wire bus time
+#define OWMH_ISR_COUNT()		(++m_isr_count)
+#define OWMH_TWI_US(time_us)	(m_twi_us += (time_us))
+
+uint32_t owmh_isr_count(void)
+{
+	return m_isr_count;
+}
+
+uint32_t owmh_active_time_us(void)
+{
+	return m_twi_us;
+}
+#else
+#define OWMH_ISR_COUNT()
+#define OWMH_TWI_US(time_us)
+#endif
+
+#ifdef OW_BUS_FAULTS
+static ow_bus_fault_t   m_fault[OW_FAULT_CHANNELS];
+#define OWMH_FAULT(fault)		ow_bus_fault_put(&m_fault[m_channel], (fault))
+#define OWMH_FAULT_RELEASED()	ow_bus_fault_released(&m_fault[m_channel])
+
+void owmh_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_FAULT_CHANNELS);
+	CRITICAL_REGION_ENTER();
+	ow_bus_fault_stats(&m_fault[channel], p_stats, clear);
+	CRITICAL_REGION_EXIT();
+}
+
+#ifdef OW_FAULT_QUARANTINE
+static void owmh_pause(uint32_t delay_us);
+
+// Skip is completed by port timer, bridge is not accessed
+bool owmh_quarantine_skip(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_FAULT_CHANNELS) && (m_state == OWMHS_IDLE));
+	if (!ow_bus_fault_skip(&m_fault[channel]))
+		return false;
+	m_state = OWMHS_SKIP;
+	owmh_pause(0);
+	return true;
+}
+#endif
+#else
+#define OWMH_FAULT(fault)		((void)0)
+#define OWMH_FAULT_RELEASED()	((void)0)
+#endif
+
+#ifdef OW_HAL_STAGING
+// Staged sequence. It is started from completion interrupt before callback of master.
+typedef struct
+{
+	uint8_t*  p_txdata;
+	uint8_t*  p_rxdata;
+	uint16_t  tx_count;
+	uint16_t  rx_count;
+	uint8_t   crc_check;       // CRC8 checking armed for staged sequence
+	bool      armed;
+} owmh_stage_t;
+
+static owmh_stage_t     m_stage;
+static owmh_callback_t  m_stage_callback;  // callback of master
+
+static void owmh_stage_callback(owmh_callback_result_t result)
+{
+	if (m_stage.armed)
+	{
+		m_stage.armed = false;
+		if ((result == OWMHCR_RESET_OK) || (result == OWMHCR_SEQUENCE_OK))
+		{
+#ifdef OW_RX_CRC8
+			owmh_rx_crc_check(m_stage.crc_check);
+#endif
+			owmh_sequence(m_stage.p_txdata, m_stage.p_rxdata, m_stage.tx_count, m_stage.rx_count);
+		}
+	}
+	m_stage_callback(result);
+}
+
+void owmh_sequence_stage(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL((!m_stage.armed) && ((tx_count) || (rx_count)));
+	m_stage.p_txdata  = p_txdata;
+	m_stage.p_rxdata  = p_rxdata;
+	m_stage.tx_count  = tx_count;
+	m_stage.rx_count  = rx_count;
+	m_stage.crc_check = 0;
+	m_stage.armed     = true;
+}
+#endif
+
+#ifdef OW_RX_CRC8
+// CRC8 is updated by every received byte. Sequence is ended on last byte of checked block,
+// if check fails.
+static uint8_t    m_rx_crc8;       // CRC8 of received bytes of current sequence
+static uint8_t    m_rx_crc_check;  // bytes to check, armed for next sequence
+static uint8_t    m_rx_crc_left;   // bytes left to end of checked block
+static bool       m_rx_crc_continue; // next sequence continues CRC8 and checked block
+
+void owmh_rx_crc_check(uint8_t check_count)
+{
+#ifdef OW_HAL_STAGING
+	if (m_stage.armed)
+	{
+		// current operation can be in progress
+		m_stage.crc_check = check_count;
+		return;
+	}
+#endif
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_check = check_count;
+}
+
+void owmh_rx_crc_continue(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_continue = true;
+}
+
+uint8_t owmh_rx_crc8(void)
+{
+	return m_rx_crc8;
+}
+#endif
+
+static void owmh_port_handler(ow_ds2482_port_evt_t evt);
+
+void owm_hal_initialize(owmh_callback_t callback)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_NOT_INITIALIZED);
+
+#ifdef OW_HAL_STAGING
+	m_stage_callback = callback;
+	m_callback = owmh_stage_callback;
+#else
+	m_callback = callback;
+#endif
+
+	// bridge state is unknown, it is reset by first operation
+	ow_ds2482_port_init(owmh_port_handler);
+	m_bridge_reset = true;
+	m_config = OW_DS2482_CONFIG_APU;
+	m_channel = 0;
+
+	m_state = OWMHS_IDLE;
+}
+
+uint32_t owm_hal_uninitialize(void)
+{
+	if (m_state != OWMHS_IDLE) return 1;
+
+	ow_ds2482_port_uninit();
+	m_state = OWMHS_NOT_INITIALIZED;
+	return 0;
+}
+
+#ifdef OW_MULTI_CHANNEL
+// Channel is selected by CHSL before next command
+void ow_set_channel(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	APP_ERROR_CHECK_BOOL(channel < OW_CHANNEL_COUNT);
+	m_channel = channel;
+}
+#endif
+
+static void owmh_transfer(uint8_t tx_length, uint8_t rx_length)
+{
+	OWMH_TWI_US(ow_ds2482_twi_us(tx_length, rx_length));
+	ow_ds2482_port_transfer(m_twi_tx, tx_length, &m_twi_rx, rx_length);
+}
+
+// 1-wire command, followed by status reading. Status of long command (reset, byte)
+// is polled after pause for its expected duration.
+static void owmh_command(uint8_t command, uint8_t parameter)
+{
+	bool     overdrive = ((m_config & OW_DS2482_CONFIG_1WS) != 0);
+	uint32_t duration_us = 0;
+
+	if (command == OW_DS2482_1WRS)
+		duration_us = (overdrive) ? OW_DS2482_RESET_OD_US : OW_DS2482_RESET_US;
+	else if ((command == OW_DS2482_1WWB) || (command == OW_DS2482_1WRB))
+		duration_us = 8 * ((overdrive) ? OW_DS2482_SLOT_OD_US : OW_DS2482_SLOT_US);
+	// command is started before status reading of the same transfer
+	m_poll_pause_us = (duration_us > OW_DS2482_POLL_PAUSE_US + ow_ds2482_twi_us(0, 1)) ?
+		(duration_us - ow_ds2482_twi_us(0, 1)) : 0;
+
+	m_step = OWMH_STEP_STATUS;
+	m_polls = 0;
+	m_twi_tx[0] = command;
+	m_twi_tx[1] = parameter;
+	owmh_transfer(((command == OW_DS2482_1WRS) || (command == OW_DS2482_1WRB)) ? 1 : 2, 1);
+}
+
+static void owmh_read_register(owmh_step_t step, uint8_t pointer)
+{
+	m_step = step;
+	m_polls = 0;
+	m_poll_pause_us = 0;
+	m_twi_tx[0] = OW_DS2482_SRP;
+	m_twi_tx[1] = pointer;
+	owmh_transfer(2, 1);
+}
+
+static void owmh_complete(owmh_callback_result_t result)
+{
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	if ((result == OWMHCR_ERROR) && (m_pullup_hw))
+	{
+		// configuration is rewritten by next operation
+		m_pullup_hw = false;
+		m_config &= (uint8_t)(~OW_DS2482_CONFIG_SPU);
+	}
+#endif
+	m_state = OWMHS_IDLE;
+	m_callback(result);
+}
+
+// Bridge does not respond as expected. It is reset before next operation
+static void owmh_bridge_error(void)
+{
+	OWMH_FAULT(OWMH_FAULT_TIMING);
+	m_bridge_reset = true;
+	owmh_complete(OWMHCR_ERROR);
+}
+
+// Failed timeslot: line is held low after it, otherwise slot is corrupted
+static owmh_callback_result_t owmh_slot_error(uint8_t status)
+{
+	OWMH_FAULT((status & OW_DS2482_STATUS_LL) ? OWMH_FAULT_TIMING : OWMH_FAULT_NO_RELEASE);
+	UNUSED_PARAMETER(status);
+	return OWMHCR_ERROR;
+}
+
+// Next command of sequence: whole bytes by 1WWB/1WRB, rest of bits by 1WSB
+static void owmh_sequence_continue(void)
+{
+	uint16_t slot = m_slot_index;
+
+	if (slot < m_tx_count)
+	{
+		uint16_t left = m_tx_count - slot;
+
+		m_slots = (((slot & 0x07) == 0) && (left >= 8)) ? 8 : 1;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		if ((m_pullup_hw) && (left == m_slots) && (!(m_config & OW_DS2482_CONFIG_SPU)))
+		{
+			// bridge engages strong pull-up right after last write command
+			m_config |= OW_DS2482_CONFIG_SPU;
+			m_step = OWMH_STEP_CONFIG;
+			m_twi_tx[0] = OW_DS2482_WCFG;
+			m_twi_tx[1] = OW_DS2482_CONFIG_BYTE(m_config);
+			owmh_transfer(2, 1);
+			return;
+		}
+#endif
+		if (m_slots == 8)
+			owmh_command(OW_DS2482_1WWB, m_p_tx_buf[slot >> 3]);
+		else
+			owmh_command(OW_DS2482_1WSB, (m_p_tx_buf[slot >> 3] & (1 << (slot & 0x07))) ? 0x80 : 0x00);
+	}
+	else
+	{
+		uint16_t rx_slot = slot - m_tx_count;
+
+		m_slots = (((rx_slot & 0x07) == 0) && ((m_slot_count - slot) >= 8)) ? 8 : 1;
+		if (m_slots == 8)
+			owmh_command(OW_DS2482_1WRB, 0);
+		else
+			owmh_command(OW_DS2482_1WSB, 0x80);
+	}
+}
+
+// Bridge reset, channel selection and configuration, then command of operation
+static void owmh_next(void)
+{
+	if (m_bridge_reset)
+	{
+		m_step = OWMH_STEP_DEVICE_RESET;
+		m_twi_tx[0] = OW_DS2482_DRST;
+		owmh_transfer(1, 1);
+		return;
+	}
+#ifdef OW_MULTI_CHANNEL
+	if (m_channel_selected != m_channel)
+	{
+		m_step = OWMH_STEP_CHANNEL;
+		m_twi_tx[0] = OW_DS2482_CHSL;
+		m_twi_tx[1] = ow_ds2482_channel_code[m_channel];
+		owmh_transfer(2, 1);
+		return;
+	}
+#endif
+	if (m_config_written != m_config)
+	{
+		m_step = OWMH_STEP_CONFIG;
+		m_twi_tx[0] = OW_DS2482_WCFG;
+		m_twi_tx[1] = OW_DS2482_CONFIG_BYTE(m_config);
+		owmh_transfer(2, 1);
+		return;
+	}
+
+	switch (m_state)
+	{
+	case OWMHS_RESET:
+		owmh_command(OW_DS2482_1WRS, 0);
+		break;
+
+	case OWMHS_WRITE:
+		owmh_command(OW_DS2482_1WSB, (m_bit) ? 0x80 : 0x00);
+		break;
+
+	case OWMHS_READ:
+	case OWMHS_READ_FLAG:
+		owmh_command(OW_DS2482_1WSB, 0x80);
+		break;
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET:
+		owmh_command(OW_DS2482_1WT, (m_bit) ? 0x80 : 0x00);
+		break;
+#endif
+
+	case OWMHS_SEQUENCE:
+		owmh_sequence_continue();
+		break;
+
+	case OWMHS_DELAY:
+		// line is checked at end of delay
+		owmh_read_register(OWMH_STEP_STATUS, OW_DS2482_PTR_STATUS);
+		break;
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+	case OWMHS_POWER_HOLD:
+		// strong pull-up is released by configuration written above
+		owmh_complete(OWMHCR_WAIT_OK);
+		break;
+#endif
+
+	default: // OWMHS_IDLE, OWMHS_FLAG_PAUSE, OWMHS_NOT_INITIALIZED
+		APP_ERROR_CHECK_BOOL(false);
+	}
+}
+
+static void owmh_start(owmh_state_t state)
+{
+	m_state = state;
+	owmh_next();
+}
+
+static void owmh_pause(uint32_t delay_us)
+{
+	m_step = OWMH_STEP_PAUSE;
+	ow_ds2482_port_timer(delay_us);
+}
+
+void owmh_reset(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	// profile of channel is applied from reset: active pull-up, except of short bus
+	if (m_profile[m_channel] == OWMH_PROFILE_FAST)
+		m_config &= (uint8_t)(~OW_DS2482_CONFIG_APU);
+	else
+		m_config |= OW_DS2482_CONFIG_APU;
+	owmh_start(OWMHS_RESET);
+}
+
+void owmh_read(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	owmh_start(OWMHS_READ);
+}
+
+void owmh_write(uint8_t bit)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_bit = bit;
+	owmh_start(OWMHS_WRITE);
+}
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+void owmh_triplet(uint8_t direction)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_bit = direction;
+	owmh_start(OWMHS_TRIPLET);
+}
+#endif
+
+void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	// timeslots of sequence are numbered by 16 bit index
+	APP_ERROR_CHECK_BOOL(((uint32_t)tx_count + rx_count) <= UINT16_MAX);
+	if ((!tx_count)&&(!rx_count)) return;
+	m_p_tx_buf = p_txdata;
+	m_p_rx_buf = p_rxdata;
+	m_tx_count = tx_count;
+	m_slot_count = (uint16_t)tx_count + rx_count;
+	m_slot_index = 0;
+#ifdef OW_RX_CRC8
+	if (!m_rx_crc_continue)
+	{
+		m_rx_crc8 = 0;
+		m_rx_crc_left = m_rx_crc_check;
+	}
+	m_rx_crc_continue = false;
+	m_rx_crc_check = 0;
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	m_pullup_hw = ((m_pullup_armed) && (rx_count == 0));
+	m_pullup_armed = false;
+#endif
+	owmh_start(OWMHS_SEQUENCE);
+}
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+// SPU bit is written before last write command of sequence
+void owmh_arm_power(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_pullup_armed = true;
+}
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+void owmh_set_speed(bool overdrive)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	if (overdrive)
+		m_config |= OW_DS2482_CONFIG_1WS;
+	else
+		m_config &= (uint8_t)(~OW_DS2482_CONFIG_1WS);
+}
+#endif
+
+void owmh_set_profile(uint8_t channel, owmh_profile_t profile)
+{
+	// slot timing is fixed by bridge, profile selects active pull-up
+	APP_ERROR_CHECK_BOOL((channel < OW_DS2482_CHANNEL_COUNT) && (profile < OWMH_PROFILE_COUNT));
+	m_profile[channel] = profile;
+}
+
+#ifdef OW_BUS_CALIBRATION
+// bridge samples bus at fixed points of its timing, there is nothing to calibrate
+void owmh_calibrate(uint8_t channel)
+{
+	UNUSED_PARAMETER(channel);
+}
+
+bool owmh_calibrated(uint8_t channel)
+{
+	UNUSED_PARAMETER(channel);
+	return false;
+}
+#endif
+
+void owmh_wait_flag(uint16_t max_wait_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_delay_counter = max_wait_ms;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	ow_flag_poll_init(&m_flag_poll, max_wait_ms);
+#endif
+	owmh_start(OWMHS_READ_FLAG);
+}
+
+void owmh_delay(uint16_t delay_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_state = OWMHS_DELAY;
+	owmh_pause((uint32_t)delay_ms * 1000);
+}
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+// Bridge engages strong pull-up only after write command (OW_HW_STRONG_PULLUP),
+// hold power without armed sequence keeps line on active or passive pull-up.
+void owmh_hold_power(uint16_t delay_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+#ifdef OW_HW_STRONG_PULLUP
+	m_pullup_armed = false;
+	m_pullup_hw = false;
+	m_config &= (uint8_t)(~OW_DS2482_CONFIG_SPU);
+#endif
+	m_state = OWMHS_POWER_HOLD;
+	owmh_pause((uint32_t)delay_ms * 1000);
+}
+#endif // defined (OW_PARASITE_POWER_SUPPORT)
+
+// Completed data byte or bit of sequence
+static void owmh_sequence_slots(void)
+{
+#ifdef OW_RX_CRC8
+	if ((m_slot_index > m_tx_count) && (((m_slot_index - m_tx_count) & 0x07) == 0))
+	{
+		// received byte completed
+		m_rx_crc8 = crc8(m_rx_crc8, m_p_rx_buf[((m_slot_index - m_tx_count) >> 3) - 1]);
+		if ((m_rx_crc_left > 0) && (--m_rx_crc_left == 0) && (m_rx_crc8 != 0))
+		{
+			// rest of sequence is not transferred
+			owmh_complete(OWMHCR_CRC_ERROR);
+			return;
+		}
+	}
+#endif
+	if (m_slot_index < m_slot_count)
+		owmh_sequence_continue();
+	else
+		owmh_complete(OWMHCR_SEQUENCE_OK);
+}
+
+static void owmh_sequence_status(uint8_t status)
+{
+	if (m_slot_index < m_tx_count)
+	{
+		// single bit is read back, written byte can not be checked
+		if ((m_slots == 1) &&
+			(((status & OW_DS2482_STATUS_SBR) != 0) != ((m_p_tx_buf[m_slot_index >> 3] & (1 << (m_slot_index & 0x07))) != 0)))
+		{
+			owmh_complete(owmh_slot_error(status));
+			return;
+		}
+	}
+	else if (m_slots == 8)
+	{
+		owmh_read_register(OWMH_STEP_DATA, OW_DS2482_PTR_DATA);
+		return;
+	}
+	else
+	{
+		uint16_t rx_slot = m_slot_index - m_tx_count;
+		uint8_t  mask = (uint8_t)(1 << (rx_slot & 0x07));
+
+		if (status & OW_DS2482_STATUS_SBR)
+			m_p_rx_buf[rx_slot >> 3] |= mask;
+		else
+			m_p_rx_buf[rx_slot >> 3] &= (uint8_t)(~mask);
+	}
+	m_slot_index += m_slots;
+	owmh_sequence_slots();
+}
+
+// Status of completed 1-wire command
+static void owmh_status(uint8_t status)
+{
+	owmh_callback_result_t result = OWMHCR_ERROR;
+#ifdef OW_ROM_SEARCH_SUPPORT
+	uint8_t  triplet;
+#endif
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	uint32_t pause;
+#endif
+
+	switch (m_state)
+	{
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_RESET:
+		if (status & OW_DS2482_STATUS_SD)
+		{
+			OWMH_FAULT(OWMH_FAULT_SHORT);
+			break;
+		}
+		OWMH_FAULT_RELEASED();
+		result = (status & OW_DS2482_STATUS_PPD) ? OWMHCR_RESET_OK : OWMHCR_RESET_NO_RESPONCE;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_WRITE:
+		if (((status & OW_DS2482_STATUS_SBR) != 0) == (m_bit != 0))
+			result = OWMHCR_WRITE_OK;
+		else
+			result = owmh_slot_error(status);
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_READ:
+		result = (status & OW_DS2482_STATUS_SBR) ? OWMHCR_READ_1 : OWMHCR_READ_0;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET:
+		triplet = 0;
+		if (status & OW_DS2482_STATUS_SBR)
+			triplet |= OWMH_TRIPLET_ID;
+		if (status & OW_DS2482_STATUS_TSB)
+			triplet |= OWMH_TRIPLET_CMP;
+		if (status & OW_DS2482_STATUS_DIR)
+			triplet |= OWMH_TRIPLET_DIR;
+		result = (owmh_callback_result_t)(OWMHCR_TRIPLET | triplet);
+		break;
+#endif
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_SEQUENCE:
+		owmh_sequence_status(status);
+		return;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_READ_FLAG:
+		if (status & OW_DS2482_STATUS_SBR)
+			result = OWMHCR_FLAG_OK;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+		else if ((pause = ow_flag_poll_next(&m_flag_poll, OW_FLAG_SLOT_US)) > 0)
+		{
+			m_state = OWMHS_FLAG_PAUSE;
+			owmh_pause(pause);
+			return;
+		}
+#else
+		else if (m_delay_counter > 0)
+		{
+			m_state = OWMHS_FLAG_PAUSE;
+			owmh_pause(OW_FLAG_PAUSE_MS * 1000);
+			return;
+		}
+#endif
+		else
+			result = OWMHCR_TIME_OUT;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_DELAY:
+		if (status & OW_DS2482_STATUS_LL)
+			result = OWMHCR_WAIT_OK;
+		else
+			OWMH_FAULT(OWMH_FAULT_NO_RELEASE);
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	default: // OWMHS_IDLE, OWMHS_FLAG_PAUSE, OWMHS_POWER_HOLD, OWMHS_NOT_INITIALIZED
+		APP_ERROR_CHECK_BOOL(false);
+//----------------------------------------------------------------------------------------------------------------
+	} // switch (m_state)
+
+	owmh_complete(result);
+}
+
+// Port timer: end of delay, hold power, pause between flag readings or skip
+static void owmh_pause_end(void)
+{
+	switch (m_state)
+	{
+	case OWMHS_FLAG_PAUSE :
+#ifndef OW_PREDICTIVE_FLAG_POLL
+		m_delay_counter -= (m_delay_counter > OW_FLAG_PAUSE_MS) ? OW_FLAG_PAUSE_MS : m_delay_counter;
+#endif
+		m_state = OWMHS_READ_FLAG;
+		owmh_next();
+		break;
+
+	case OWMHS_DELAY :
+		owmh_next();
+		break;
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+	case OWMHS_POWER_HOLD :
+#ifdef OW_HW_STRONG_PULLUP
+		m_config &= (uint8_t)(~OW_DS2482_CONFIG_SPU);
+#endif
+		owmh_next();
+		break;
+#endif
+
+#ifdef OW_FAULT_QUARANTINE
+	case OWMHS_SKIP :
+		m_state = OWMHS_IDLE;
+		m_callback(OWMHCR_ERROR);
+		break;
+#endif
+
+	default: // any state with I2C transfer in progress
+		APP_ERROR_CHECK_BOOL(false);
+	}
+}
+
+// Port event handler. Invoked once per I2C transfer or timer expiration.
+static void owmh_port_handler(ow_ds2482_port_evt_t evt)
+{
+	OWMH_ISR_COUNT();
+
+	if (evt == OW_DS2482_PORT_NACK)
+	{
+		owmh_bridge_error();
+		return;
+	}
+
+	switch (m_step)
+	{
+	case OWMH_STEP_PAUSE:
+		owmh_pause_end();
+		break;
+
+	case OWMH_STEP_DEVICE_RESET:
+		if (!(m_twi_rx & OW_DS2482_STATUS_RST))
+		{
+			owmh_bridge_error();
+			break;
+		}
+		// power-on state: channel 0 (IO0), all configuration bits cleared
+		m_bridge_reset = false;
+		m_config_written = 0;
+		m_channel_selected = 0;
+		owmh_next();
+		break;
+
+#ifdef OW_MULTI_CHANNEL
+	case OWMH_STEP_CHANNEL:
+		if (m_twi_rx != ow_ds2482_channel_readback[m_channel])
+		{
+			owmh_bridge_error();
+			break;
+		}
+		m_channel_selected = m_channel;
+		owmh_next();
+		break;
+#endif
+
+	case OWMH_STEP_CONFIG:
+		if (m_twi_rx != m_config)
+		{
+			owmh_bridge_error();
+			break;
+		}
+		m_config_written = m_config;
+		owmh_next();
+		break;
+
+	case OWMH_STEP_STATUS:
+		if (m_twi_rx & OW_DS2482_STATUS_1WB)
+		{
+			// read pointer stays on status register
+			if (++m_polls > OW_DS2482_POLL_LIMIT)
+				owmh_bridge_error();
+			else if ((m_polls == 1) && (m_poll_pause_us > 0))
+			{
+				m_step = OWMH_STEP_POLL_PAUSE;
+				ow_ds2482_port_timer(m_poll_pause_us);
+			}
+			else
+				owmh_transfer(0, 1);
+			break;
+		}
+		owmh_status(m_twi_rx);
+		break;
+
+	case OWMH_STEP_POLL_PAUSE:
+		m_step = OWMH_STEP_STATUS;
+		owmh_transfer(0, 1);
+		break;
+
+	case OWMH_STEP_DATA:
+		m_p_rx_buf[(m_slot_index - m_tx_count) >> 3] = m_twi_rx;
+		m_slot_index += 8;
+		owmh_sequence_slots();
+		break;
+
+	default:
+		APP_ERROR_CHECK_BOOL(false);
+	}
+}
+
+#endif // OW_HAL_DS2482
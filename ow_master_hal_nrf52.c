@@ -1,4 +1,8 @@
 
+#include "ow_master_hal.h"
+
+#ifdef OW_HAL_TIMER
+
 #include <nrfx.h>
 #include "nrf_drv_gpiote.h"
 #include <nrfx_gpiote.h>
@@ -6,10 +10,31 @@
 #include <hal/nrf_gpio.h>
 #include "nrf_drv_ppi.h"
 #include "nrf_drv_timer.h"
+#ifdef OW_SLOT_ENGINE
+#include <hal/nrf_ppi.h>
+#endif
 
 #include "app_error.h"
-
-#include "ow_master_hal.h"
+#ifdef OW_LOW_POWER_DELAY
+#include "app_timer.h"
+#endif
+#ifdef OW_PREDICTIVE_FLAG_POLL
+#include "ow_flag_poll.h"
+#endif
+#ifdef OW_RX_CRC8
+#include "ow_packet.h"
+#endif
+#ifdef OW_SLOT_HISTOGRAM
+#include <string.h>
+#include "app_util_platform.h"
+#endif
+#ifdef OW_TRACE
+#include "ow_trace.h"
+#endif
+#ifdef OW_BUS_FAULTS
+#include "app_util_platform.h"
+#include "ow_bus_fault.h"
+#endif
 
 // OW master HAL states
 typedef enum
@@ -21,7 +46,16 @@ typedef enum
 	OWMHS_WRITE0,
 	OWMHS_WRITE1,
 
+#ifdef OW_ROM_SEARCH_SUPPORT
+	OWMHS_TRIPLET_ID,
+	OWMHS_TRIPLET_CMP,
+	OWMHS_TRIPLET_DIR,
+#endif
+
 	OWMHS_SEQUENCE,
+#ifdef OW_SLOT_ENGINE
+	OWMHS_SEQUENCE_TAIL,
+#endif
 
 	OWMHS_READ_FLAG,
 	OWMHS_FLAG_PAUSE,
@@ -29,36 +63,399 @@ typedef enum
 #ifdef OW_PARASITE_POWER_SUPPORT
 	OWMHS_POWER_HOLD,
 #endif
+#ifdef OW_FAULT_QUARANTINE
+	OWMHS_SKIP,                    // packet of quarantined channel, no bus activity
+#endif
 
 	OWMHS_NOT_INITIALIZED
 } owmh_state_t;
 
 #define DELAY_MKS(delay_microseconds) ((delay_microseconds)*16)
 
-#define OW_READ_PULSE			DELAY_MKS(5)
+// 1-wire timing set of bus speed, timer ticks
+typedef struct
+{
+	uint32_t read_pulse;          //*< read and write 1 strobe                    */
+	uint32_t write0_pulse;        //*< write 0 pulse                              */
+	uint32_t reset_pulse;         //*< reset pulse                                */
+	uint32_t write1_tolerance;    //*< allowed prolongation of write 1 pulse      */
+	uint32_t write0_tolerance;    //*< allowed prolongation of write 0 pulse      */
+	uint32_t write_slot;          //*< write timeslot with recovery time          */
+	uint32_t read_slot;           //*< read timeslot with recovery time           */
+	uint32_t reset_slot;          //*< reset pulse and presence detection zone    */
+	uint32_t read1_bound;         //*< edge before bound - 1 readed               */
+	uint32_t read0_bound;         //*< edge after bound - 0 readed                */
+	uint32_t presence_bound;      //*< edge after bound - presence detected       */
+} owmh_timing_t;
+
+// Standard speed timing sets, indexed by owmh_profile_t
+static const owmh_timing_t ow_timing_profiles[OWMH_PROFILE_COUNT] =
+{
+	[OWMH_PROFILE_STANDARD] =
+	{
+		.read_pulse       = DELAY_MKS(5),
+		.write0_pulse     = DELAY_MKS(60),
+		.reset_pulse      = DELAY_MKS(600),
+		.write1_tolerance = DELAY_MKS(2),
+		.write0_tolerance = DELAY_MKS(2),
+		.write_slot       = DELAY_MKS(70),
+		.read_slot        = DELAY_MKS(100),
+		.reset_slot       = DELAY_MKS(600+300),
+		.read1_bound      = DELAY_MKS(10),
+		.read0_bound      = DELAY_MKS(15),
+		.presence_bound   = DELAY_MKS(600+60)
+	},
+	// short bus: sharp edges, minimal recovery times
+	[OWMH_PROFILE_FAST] =
+	{
+		.read_pulse       = DELAY_MKS(3),
+		.write0_pulse     = DELAY_MKS(60),
+		.reset_pulse      = DELAY_MKS(500),
+		.write1_tolerance = DELAY_MKS(1),
+		.write0_tolerance = DELAY_MKS(1),
+		.write_slot       = DELAY_MKS(63),
+		.read_slot        = DELAY_MKS(65),
+		.reset_slot       = DELAY_MKS(500+310),
+		.read1_bound      = DELAY_MKS(6),
+		.read0_bound      = DELAY_MKS(10),
+		.presence_bound   = DELAY_MKS(500+30)
+	},
+	// long line: slow rising edges, extended recovery times
+	[OWMH_PROFILE_LONG_LINE] =
+	{
+		.read_pulse       = DELAY_MKS(5),
+		.write0_pulse     = DELAY_MKS(60),
+		.reset_pulse      = DELAY_MKS(600),
+		.write1_tolerance = DELAY_MKS(5),
+		.write0_tolerance = DELAY_MKS(5),
+		.write_slot       = DELAY_MKS(85),
+		.read_slot        = DELAY_MKS(110),
+		.reset_slot       = DELAY_MKS(600+400),
+		.read1_bound      = DELAY_MKS(12),
+		.read0_bound      = DELAY_MKS(15),
+		.presence_bound   = DELAY_MKS(600+60)
+	}
+};
+
+#ifdef OW_OVERDRIVE_SUPPORT
+static const owmh_timing_t ow_timing_overdrive =
+{
+	.read_pulse       = DELAY_MKS(1),
+	.write0_pulse     = DELAY_MKS(8),
+	.reset_pulse      = DELAY_MKS(74),
+	.write1_tolerance = DELAY_MKS(1),
+	.write0_tolerance = DELAY_MKS(1),
+	.write_slot       = DELAY_MKS(11),
+	.read_slot        = DELAY_MKS(15),
+	.reset_slot       = DELAY_MKS(74+50),
+	.read1_bound      = DELAY_MKS(3)/2,
+	.read0_bound      = DELAY_MKS(2),
+	.presence_bound   = DELAY_MKS(74+2)
+};
+#endif
+
+#ifdef OW_MULTI_CHANNEL
+#define OW_PROFILE_CHANNELS		OW_CHANNEL_COUNT
+#else
+#define OW_PROFILE_CHANNELS		1
+#endif
+
+#ifdef OW_CHANNEL_PROFILES
+static owmh_profile_t m_channel_profile[OW_PROFILE_CHANNELS] = OW_CHANNEL_PROFILES;
+#else
+static owmh_profile_t m_channel_profile[OW_PROFILE_CHANNELS];
+#endif
+static uint8_t  m_channel;      // current channel
+#ifdef OW_OVERDRIVE_SUPPORT
+static bool     m_overdrive;    // current bus speed
+#endif
+
+static const owmh_timing_t* m_p_timing = &ow_timing_profiles[OWMH_PROFILE_STANDARD];
+
+#ifdef OW_BUS_CALIBRATION
+// Bus calibration. Edges of successful timeslots are collected per channel:
+// line rise time after release, release of line by device in read 0 slots and
+// end of presence pulse. Calibrated timing is derived from them on next reset.
+
+#define OW_CALIB_MIN_EDGES		16              // minimal statistics for derivation
+#define OW_CALIB_MAX_ERRORS		3               // errors in window to fall back to profile
+#define OW_CALIB_WINDOW			1024            // timeslots, error counting and background period
+#define OW_CALIB_MARGIN			DELAY_MKS(2)
+#define OW_CALIB_PRESENCE_MARGIN	DELAY_MKS(30)   // presence pulse of other devices can be longer
+#define OW_CALIB_MIN_SLOT		DELAY_MKS(61)   // minimal timeslot by 1-wire specification
+
+typedef struct
+{
+	uint32_t      max_rise;         //*< line rise time after release                */
+	uint32_t      min_read0;        //*< earliest release of line by device (read 0) */
+	uint32_t      max_read0;        //*< latest release of line by device (read 0)   */
+	uint32_t      max_presence;     //*< latest end of presence pulse                */
+	uint16_t      rise_count;
+	uint16_t      read0_count;
+	uint16_t      presence_count;
+	uint16_t      slot_count;       //*< timeslots in current window                 */
+	uint8_t       error_count;      //*< errors in current window                    */
+	bool          request;          //*< derivation on next reset requested          */
+	bool          active;           //*< calibrated timing in use                    */
+	owmh_timing_t timing;           //*< calibrated timing                           */
+} owmh_calib_t;
+
+static owmh_calib_t m_calib[OW_PROFILE_CHANNELS];
+
+static void owmh_calib_slot(owmh_calib_t* p_calib)
+{
+	if (++p_calib->slot_count >= OW_CALIB_WINDOW)
+	{
+		p_calib->slot_count  = 0;
+		p_calib->error_count = 0;
+#ifdef OW_BUS_CALIBRATION_BACKGROUND
+		p_calib->request = true;
+#endif
+	}
+}
+
+// released line, edge after strobe
+static void owmh_calib_rise(uint32_t strobe, uint32_t edge)
+{
+	owmh_calib_t* p_calib = &m_calib[m_channel];
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	if ((edge - strobe) > p_calib->max_rise)
+		p_calib->max_rise = edge - strobe;
+	if (p_calib->rise_count < UINT16_MAX)
+		++p_calib->rise_count;
+	owmh_calib_slot(p_calib);
+}
+
+// line released by device in read 0 slot
+static void owmh_calib_read0(uint32_t edge)
+{
+	owmh_calib_t* p_calib = &m_calib[m_channel];
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	if ((p_calib->read0_count == 0) || (edge < p_calib->min_read0))
+		p_calib->min_read0 = edge;
+	if (edge > p_calib->max_read0)
+		p_calib->max_read0 = edge;
+	if (p_calib->read0_count < UINT16_MAX)
+		++p_calib->read0_count;
+	owmh_calib_slot(p_calib);
+}
+
+// end of presence pulse
+static void owmh_calib_presence(uint32_t edge)
+{
+	owmh_calib_t* p_calib = &m_calib[m_channel];
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	if (edge > p_calib->max_presence)
+		p_calib->max_presence = edge;
+	if (p_calib->presence_count < UINT16_MAX)
+		++p_calib->presence_count;
+}
+
+// timing error on channel. Calibrated timing is dropped if errors rise
+static void owmh_calib_error(void)
+{
+	owmh_calib_t* p_calib = &m_calib[m_channel];
+	if ((p_calib->active) && (++p_calib->error_count >= OW_CALIB_MAX_ERRORS))
+	{
+		p_calib->active = false;
+		p_calib->error_count = 0;
+		// statistics collected again in profile timing
+		p_calib->rise_count = 0;
+		p_calib->read0_count = 0;
+		p_calib->presence_count = 0;
+		p_calib->max_rise = 0;
+		p_calib->max_read0 = 0;
+		p_calib->max_presence = 0;
+	}
+}
+
+// Derivation of calibrated timing from channel profile and collected edges.
+// Calibrated timing is never slower than profile.
+static void owmh_calib_apply(uint8_t channel)
+{
+	owmh_calib_t* p_calib = &m_calib[channel];
+	owmh_timing_t timing  = ow_timing_profiles[m_channel_profile[channel]];
+	uint32_t      recovery;
+	uint32_t      value;
+
+	p_calib->request = false;
+	if ((p_calib->rise_count < OW_CALIB_MIN_EDGES) || (p_calib->read0_count < OW_CALIB_MIN_EDGES)
+			|| (p_calib->presence_count == 0))
+		return;
+
+	recovery = 2 * p_calib->max_rise + OW_CALIB_MARGIN;
+	timing.write1_tolerance = p_calib->max_rise + OW_CALIB_MARGIN;
+	timing.write0_tolerance = p_calib->max_rise + OW_CALIB_MARGIN;
+	timing.read1_bound = timing.read_pulse + p_calib->max_rise + OW_CALIB_MARGIN;
+	timing.read0_bound = p_calib->min_read0 - OW_CALIB_MARGIN;
+	if (timing.read1_bound >= timing.read0_bound)
+		return; // no safe gap between 1 and 0 edges
+
+	value = timing.write0_pulse + timing.write0_tolerance + recovery;
+	if (value < timing.write_slot)
+		timing.write_slot = (value < OW_CALIB_MIN_SLOT) ? OW_CALIB_MIN_SLOT : value;
+	// edge later than slot end - 30 is treated as error by timer handler
+	value = p_calib->max_read0 + OW_CALIB_MARGIN + recovery + 30;
+	if (value < timing.read_slot)
+		timing.read_slot = (value < OW_CALIB_MIN_SLOT) ? OW_CALIB_MIN_SLOT : value;
+	value = p_calib->max_presence + OW_CALIB_PRESENCE_MARGIN + recovery + 30;
+	if (value < timing.reset_slot)
+		timing.reset_slot = value;
+
+	p_calib->timing = timing;
+	p_calib->error_count = 0;
+	p_calib->active = true;
+}
+
+#define OWMH_CALIB_RISE(strobe, edge)	owmh_calib_rise((strobe), (edge))
+#define OWMH_CALIB_READ0(edge)			owmh_calib_read0(edge)
+#define OWMH_CALIB_PRESENCE(edge)		owmh_calib_presence(edge)
+#define OWMH_CALIB_ERROR()				owmh_calib_error()
+#else
+#define OWMH_CALIB_RISE(strobe, edge)	((void)0)
+#define OWMH_CALIB_READ0(edge)			((void)0)
+#define OWMH_CALIB_PRESENCE(edge)		((void)0)
+#define OWMH_CALIB_ERROR()				((void)0)
+#endif // OW_BUS_CALIBRATION
+
+#define OW_READ_PULSE			(m_p_timing->read_pulse)
 #define OW_WRITE1_PULSE			OW_READ_PULSE 
-#define OW_WRITE0_PULSE			DELAY_MKS(60)
-#define OW_RESET_PULSE			DELAY_MKS(600)
+#define OW_WRITE0_PULSE			(m_p_timing->write0_pulse)
+#define OW_RESET_PULSE			(m_p_timing->reset_pulse)
 
-#define OW_WRITE1_PULSE_TOLERANCE	DELAY_MKS(2)
-#define OW_WRITE0_PULSE_TOLERANCE	DELAY_MKS(2)
+#define OW_WRITE1_PULSE_TOLERANCE	(m_p_timing->write1_tolerance)
+#define OW_WRITE0_PULSE_TOLERANCE	(m_p_timing->write0_tolerance)
 
-#define OW_WRITE_TIMESLOT_DELAY	DELAY_MKS(70)
-#define OW_READ_TIMESLOT_DELAY	DELAY_MKS(100)
-#define OW_RESET_DELAY			DELAY_MKS(600+300)
+#define OW_WRITE_TIMESLOT_DELAY	(m_p_timing->write_slot)
+#define OW_READ_TIMESLOT_DELAY	(m_p_timing->read_slot)
+#define OW_RESET_DELAY			(m_p_timing->reset_slot)
 
 #define OW_MILLISECOND_DELAY	DELAY_MKS(1000)
 #define OW_FLAG_PAUSE_DELAY	(OW_MILLISECOND_DELAY - OW_READ_TIMESLOT_DELAY)
 
-#define OW_READ1_BOUND			DELAY_MKS(10)
-#define OW_READ0_BOUND			DELAY_MKS(15)
-#define OW_PRESENCE_BOUND		DELAY_MKS(600+60)
+#define OW_READ1_BOUND			(m_p_timing->read1_bound)
+#define OW_READ0_BOUND			(m_p_timing->read0_bound)
+#define OW_PRESENCE_BOUND		(m_p_timing->presence_bound)
+
+#ifdef OW_SLOT_HISTOGRAM
+// Slot histograms. Edges of successful timeslots are counted per channel in bins,
+// read edges close to bounds of gap between 1 and 0 are counted separately.
+// Overdrive slots are not collected, as in calibration.
+#define OW_HIST_NEAR_MARGIN		DELAY_MKS(3)
+
+static owmh_slot_stats_t m_slot_stats[OW_PROFILE_CHANNELS];
+
+// bin width of edge kinds, log2 of timer ticks: 1 us, 1 us, 4 us, 1 us, 16 us
+static const uint8_t ow_hist_shift[OWMH_HIST_COUNT] = { 4, 4, 6, 4, 8 };
+
+static void owmh_hist_bin(owmh_slot_stats_t* p_stats, owmh_hist_t kind, uint32_t value)
+{
+	uint16_t* p_bin;
+
+	value >>= ow_hist_shift[kind];
+	p_bin = &p_stats->bins[kind][(value < OWMH_HIST_BINS) ? value : (OWMH_HIST_BINS - 1)];
+	if (*p_bin < UINT16_MAX)
+		++(*p_bin);
+}
+
+static void owmh_hist(owmh_hist_t kind, uint32_t value)
+{
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	owmh_hist_bin(&m_slot_stats[m_channel], kind, value);
+}
+
+static void owmh_hist_read1(uint32_t edge)
+{
+	owmh_slot_stats_t* p_stats = &m_slot_stats[m_channel];
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	if (((edge + OW_HIST_NEAR_MARGIN) >= OW_READ1_BOUND) && (p_stats->near_read1 < UINT16_MAX))
+		++p_stats->near_read1;
+	owmh_hist_bin(p_stats, OWMH_HIST_READ1, edge - OW_READ_PULSE);
+}
+
+static void owmh_hist_read0(uint32_t edge)
+{
+	owmh_slot_stats_t* p_stats = &m_slot_stats[m_channel];
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive) return;
+#endif
+	if ((edge <= (OW_READ0_BOUND + OW_HIST_NEAR_MARGIN)) && (p_stats->near_read0 < UINT16_MAX))
+		++p_stats->near_read0;
+	owmh_hist_bin(p_stats, OWMH_HIST_READ0, edge);
+}
+
+void owmh_slot_stats(uint8_t channel, owmh_slot_stats_t* p_stats, bool clear)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_PROFILE_CHANNELS);
+	CRITICAL_REGION_ENTER();
+	*p_stats = m_slot_stats[channel];
+	if (clear)
+		memset(&m_slot_stats[channel], 0, sizeof(owmh_slot_stats_t));
+	CRITICAL_REGION_EXIT();
+}
+
+#define OWMH_HIST_WRITE(bit, edge)		owmh_hist((bit) ? OWMH_HIST_WRITE1 : OWMH_HIST_WRITE0, \
+											(edge) - ((bit) ? OW_WRITE1_PULSE : OW_WRITE0_PULSE))
+#define OWMH_HIST_READ1(edge)			owmh_hist_read1(edge)
+#define OWMH_HIST_READ0(edge)			owmh_hist_read0(edge)
+#define OWMH_HIST_PRESENCE(edge)		owmh_hist(OWMH_HIST_PRESENCE, (edge) - OW_RESET_PULSE)
+#else
+#define OWMH_HIST_WRITE(bit, edge)		((void)0)
+#define OWMH_HIST_READ1(edge)			((void)0)
+#define OWMH_HIST_READ0(edge)			((void)0)
+#define OWMH_HIST_PRESENCE(edge)		((void)0)
+#endif // OW_SLOT_HISTOGRAM
 
 static const nrf_drv_timer_t ow_timer = NRF_DRV_TIMER_INSTANCE(OW_TIMER_INSTANCE);
 
 static nrf_ppi_channel_t m_ppi_channel_capture;
 static nrf_ppi_channel_t m_ppi_channel_strobe_end;
 
+#ifdef OW_SLOT_ENGINE
+#if (OW_TIMER_INSTANCE < 3)
+#error "OW_SLOT_ENGINE requires TIMER3 or TIMER4 (6 CC registers) as OW_TIMER_INSTANCE"
+#endif
+
+// Number of timeslots chained by hardware between two interrupts. Limited by
+// spare capture registers of 1-wire timer: CC3..CC5 for edges routed by counter,
+// CC0 for last edge of batch. CC3 is end of write 0 pulse in write batches, so every
+// edge of write batch is captured with one slot less.
+#define OW_ENGINE_SLOTS			4
+#define OW_ENGINE_TX_SLOTS		(OW_ENGINE_SLOTS - 1)
+#define OW_ENGINE_COUNT_NEVER	0xFFFF
+
+static const nrf_drv_timer_t ow_counter = NRF_DRV_TIMER_INSTANCE(OW_COUNTER_TIMER_INSTANCE);
+
+static nrf_ppi_channel_t m_ppi_channel_strobe;       // end of slot -> strobe of next slot
+static nrf_ppi_channel_t m_ppi_channel_release0;     // end of write 0 pulse (CC3)
+static nrf_ppi_channel_t m_ppi_channel_batch_end;    // last edge of batch -> timer stop
+static nrf_ppi_channel_t m_ppi_channel_route[OW_ENGINE_SLOTS - 1]; // edge of slot -> capture
+static nrf_ppi_channel_group_t m_ppi_group_release1; // end of write 1 pulse (CC1) enabled
+
+static const nrf_timer_cc_channel_t engine_capture_cc[OW_ENGINE_SLOTS - 1] =
+	{ NRF_TIMER_CC_CHANNEL3, NRF_TIMER_CC_CHANNEL4, NRF_TIMER_CC_CHANNEL5 };
+static const nrf_timer_task_t engine_capture_task[OW_ENGINE_SLOTS - 1] =
+	{ NRF_TIMER_TASK_CAPTURE3, NRF_TIMER_TASK_CAPTURE4, NRF_TIMER_TASK_CAPTURE5 };
+static const nrf_timer_cc_channel_t engine_route_cc[OW_ENGINE_SLOTS - 1] =
+	{ NRF_TIMER_CC_CHANNEL0, NRF_TIMER_CC_CHANNEL1, NRF_TIMER_CC_CHANNEL2 };
+
+static uint16_t   m_engine_index;    // bits of current direction already transferred
+static uint8_t    m_batch_count;     // timeslots in batch under processing
+static bool       m_batch_tx;        // batch of write timeslots
+
+static void ow_counter_event_handler(nrf_timer_event_t event_type, void * p_context);
+#endif // OW_SLOT_ENGINE
+
 static uint32_t         m_out_pin;
 static uint32_t         m_in_pin;
 #if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
@@ -78,43 +475,695 @@ typedef struct
 } ow_channal_rec_t;
 
 static const ow_channal_rec_t ow_pins[OW_CHANNEL_COUNT] = OW_PINS_ARRAY;
+
+#ifdef OW_CHANNEL_PREALLOCATED
+#if (OW_CHANNEL_COUNT > 4)
+#error "OW_CHANNEL_PREALLOCATED: every channel takes 2 of 8 GPIOTE channels and PPI group"
+#endif
+
+// GPIOTE and PPI of all channels are set up at initialization. Channel is switched
+// by PPI group tasks, handles of current channel are copied to m_ppi_channel_*.
+typedef struct
+{
+	nrf_ppi_channel_t       capture;
+	nrf_ppi_channel_t       strobe_end;
+#ifdef OW_SLOT_ENGINE
+	nrf_ppi_channel_t       strobe;
+	nrf_ppi_channel_t       release0;
+#endif
+	nrf_ppi_channel_group_t group;      // capture and strobe_end of channel
+} ow_channel_ppi_t;
+
+static ow_channel_ppi_t        m_channel_ppi[OW_CHANNEL_COUNT];
+static nrf_ppi_channel_group_t m_ppi_group_channel;   // group of current channel
+#endif
+#elif (defined (OW_CHANNEL_PREALLOCATED))
+#error "OW_CHANNEL_PREALLOCATED requires OW_MULTI_CHANNEL"
 #endif // (defined (OW_MULTI_CHANNEL))
 
+#ifdef OW_BROADCAST
+#ifndef OW_CHANNEL_PREALLOCATED
+#error "OW_BROADCAST requires OW_CHANNEL_PREALLOCATED"
+#endif
+
+// Broadcast. PPI groups of all channels of set are enabled, so end of pulse (CC1) releases
+// lines of all channels, edge of every channel is captured to own CC register.
+// CC1 and CC2 are pulse and slot ends, other registers capture edges.
+#if (OW_TIMER_INSTANCE < 3)
+#define OW_BROADCAST_MAX	2
+#else
+#define OW_BROADCAST_MAX	4
+#endif
+#define OW_BROADCAST_CHANNELS	(((1u << OW_GROUP_END_CHANNEL) - 1) & (~((1u << OW_GROUP_FIRST_CHANNEL) - 1)))
+
+static const nrf_timer_cc_channel_t broadcast_capture_cc[OW_BROADCAST_MAX] =
+#if (OW_BROADCAST_MAX > 2)
+	{ NRF_TIMER_CC_CHANNEL0, NRF_TIMER_CC_CHANNEL3, NRF_TIMER_CC_CHANNEL4, NRF_TIMER_CC_CHANNEL5 };
+#else
+	{ NRF_TIMER_CC_CHANNEL0, NRF_TIMER_CC_CHANNEL3 };
+#endif
+static const nrf_timer_task_t broadcast_capture_task[OW_BROADCAST_MAX] =
+#if (OW_BROADCAST_MAX > 2)
+	{ NRF_TIMER_TASK_CAPTURE0, NRF_TIMER_TASK_CAPTURE3, NRF_TIMER_TASK_CAPTURE4, NRF_TIMER_TASK_CAPTURE5 };
+#else
+	{ NRF_TIMER_TASK_CAPTURE0, NRF_TIMER_TASK_CAPTURE3 };
+#endif
+
+static uint8_t m_broadcast;                          // active channels of broadcast set
+static uint8_t m_broadcast_cc[OW_CHANNEL_COUNT];     // capture register index of channel
+#define OWMH_BROADCAST		(m_broadcast != 0)
+#else
+#define OWMH_BROADCAST		false
+#endif // OW_BROADCAST
+
 static volatile owmh_state_t m_state = OWMHS_NOT_INITIALIZED; 
 static uint8_t    m_tx_bit;
 static uint8_t*   m_p_tx_buf;
 static uint8_t*   m_p_rx_buf;
-static uint8_t    m_tx_count;
-static uint8_t    m_rx_count;
+static uint16_t   m_tx_count;
+static uint16_t   m_rx_count;
 static uint8_t    m_byte_mask;
 static uint16_t   m_delay_counter;
+#ifdef OW_ROM_SEARCH_SUPPORT
+static uint8_t    m_triplet;         // OWMH_TRIPLET_* bits of triplet under processing
+#endif
+
+#ifdef OW_BUS_FAULTS
+static ow_bus_fault_t m_fault[OW_PROFILE_CHANNELS];
+
+void owmh_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_PROFILE_CHANNELS);
+	CRITICAL_REGION_ENTER();
+	ow_bus_fault_stats(&m_fault[channel], p_stats, clear);
+	CRITICAL_REGION_EXIT();
+}
+
+#ifdef OW_FAULT_QUARANTINE
+static void owmh_continue(uint32_t pulse, uint32_t delay);
+
+// Skip is completed by timer interrupt after 1 us, line is not strobed in this state
+bool owmh_quarantine_skip(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_PROFILE_CHANNELS) && (m_state == OWMHS_IDLE));
+	if (!ow_bus_fault_skip(&m_fault[channel]))
+		return false;
+	m_state = OWMHS_SKIP;
+	owmh_continue(DELAY_MKS(1) + 10, DELAY_MKS(1));
+	return true;
+}
+#endif
+
+// Failed slot: line is held low at its end, or edge is out of window of slot
+static void owmh_fault_slot(void)
+{
+	if (!nrf_gpio_pin_read(m_in_pin))
+		ow_bus_fault_put(&m_fault[m_channel], OWMH_FAULT_NO_RELEASE);
+	else
+		ow_bus_fault_put(&m_fault[m_channel], (m_state == OWMHS_RESET) ? OWMH_FAULT_PRESENCE : OWMH_FAULT_TIMING);
+}
+#define OWMH_FAULT(fault)			ow_bus_fault_put(&m_fault[m_channel], fault)
+#define OWMH_FAULT_SLOT()			owmh_fault_slot()
+#define OWMH_FAULT_RELEASED()		ow_bus_fault_released(&m_fault[m_channel])
+#else
+#define OWMH_FAULT(fault)			((void)0)
+#define OWMH_FAULT_SLOT()			((void)0)
+#define OWMH_FAULT_RELEASED()		((void)0)
+#endif
+
+#ifdef OW_HAL_ISR_COUNTER
+static uint32_t   m_isr_count;
+static uint32_t   m_active_ticks;  // running time of 1-wire timer (HFCLK requested)
+#define OWMH_ISR_COUNT()			(++m_isr_count)
+#define OWMH_ACTIVE_TICKS(ticks)	(m_active_ticks += (ticks))
+#define OWMH_ACTIVE_TICKS_SUB(ticks)	(m_active_ticks -= (ticks))  // slot shortened by early end
+
+uint32_t owmh_isr_count(void)
+{
+	return m_isr_count;
+}
+
+uint32_t owmh_active_time_us(void)
+{
+	return m_active_ticks / DELAY_MKS(1);
+}
+#else
+#define OWMH_ISR_COUNT()
+#define OWMH_ACTIVE_TICKS(ticks)
+#define OWMH_ACTIVE_TICKS_SUB(ticks)
+#endif
 
 static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_context);
 
-static const nrf_drv_gpiote_out_config_t ow_gpiote_out_config =
+#if ((defined (OW_RESET_EARLY_EXIT)) || (defined (OW_HOT_PLUG)))
+// GPIOTE interrupt of in pin. Event stays enabled for PPI capture, so stale event of
+// previous slots is cleared before interrupt is enabled.
+static void owmh_in_int_set(nrfx_gpiote_pin_t pin, bool enable)
+{
+	uint32_t channel = (nrf_drv_gpiote_in_event_addr_get(pin) - nrf_gpiote_event_addr_get(NRF_GPIOTE_EVENTS_IN_0))
+		/ sizeof(uint32_t);
+
+	if (enable)
+	{
+		NRF_GPIOTE->EVENTS_IN[channel] = 0;
+		nrf_gpiote_int_enable(1UL << channel);
+	}
+	else
+		nrf_gpiote_int_disable(1UL << channel);
+}
+#endif
+
+#ifdef OW_RESET_EARLY_EXIT
+// Early end of reset slot. Rising edges of in pin are captured by PPI anyway, its GPIOTE
+// interrupt is enabled by reset slot start and disabled at its end. Rising edge after
+// presence bound is end of presence pulse, so reset slot is finished OW_RESET_EARLY_EXIT
+// us after it by moving CC2. Line is already released, timer interrupt validates capture as usual.
+#define OW_RESET_RECOVERY		DELAY_MKS(OW_RESET_EARLY_EXIT)
+
+static void owmh_reset_edge(void)
+{
+	uint32_t edge;
+	uint32_t now;
+	uint32_t end;
+
+	CRITICAL_REGION_ENTER();
+	// reset slot can be finished by timer interrupt of higher priority meanwhile
+	if ((m_state == OWMHS_RESET) && (!OWMH_BROADCAST) &&
+		(!nrf_timer_event_check(ow_timer.p_reg, NRF_TIMER_EVENT_COMPARE2)))
+	{
+		edge = nrf_drv_timer_capture_get(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+		if ((edge > OW_PRESENCE_BOUND) && (edge <= (OW_RESET_DELAY - 30)))
+		{
+			end = edge + OW_RESET_RECOVERY;
+			now = nrfx_timer_capture(&ow_timer, NRF_TIMER_CC_CHANNEL3) + DELAY_MKS(2);
+			if (end < now)
+				end = now;
+			if (end < OW_RESET_DELAY)
+			{
+				nrf_drv_timer_compare(&ow_timer, NRF_TIMER_CC_CHANNEL2, end, true);
+				OWMH_ACTIVE_TICKS_SUB(OW_RESET_DELAY - end);
+			}
+		}
+	}
+	CRITICAL_REGION_EXIT();
+}
+#endif
+
+#ifdef OW_HOT_PLUG
+#if ((defined (OW_MULTI_CHANNEL)) && (!defined (OW_CHANNEL_PREALLOCATED)))
+#error "OW_HOT_PLUG requires OW_CHANNEL_PREALLOCATED in multi channel configuration"
+#endif
+// Hot-plug detection. In pins of all channels are GPIOTE channels, so rising edge on line
+// of idle channel (end of presence pulse of attached device) is reported to handler of
+// the channel once, until channel is armed again. Interrupt of in pin of current channel
+// is disabled while HAL is busy (except of reset slot with early exit), its stale event
+// is cleared at completion.
+static owmh_hot_plug_handler_t m_hot_plug_handler[OW_PROFILE_CHANNELS];
+static uint32_t                m_hot_plug_armed;     // armed channels
+
+void owmh_hot_plug_arm(uint8_t channel, owmh_hot_plug_handler_t handler)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_GROUP_END_CHANNEL);
+	CRITICAL_REGION_ENTER();
+	m_hot_plug_handler[channel] = handler;
+	m_hot_plug_armed |= (1UL << channel);
+	CRITICAL_REGION_EXIT();
+}
+
+// False, if edge belongs to own transfer on current channel
+static bool owmh_hot_plug_edge(nrfx_gpiote_pin_t pin)
+{
+	uint8_t channel = OW_GROUP_FIRST_CHANNEL;
+	bool    report;
+
+	if ((pin == m_in_pin) && (m_state != OWMHS_IDLE))
+		return false;
+#ifdef OW_MULTI_CHANNEL
+	while ((channel < OW_GROUP_END_CHANNEL) && (ow_pins[channel].rx_pin != pin))
+		++channel;
+	if (channel == OW_GROUP_END_CHANNEL)
+		return true;
+#ifdef OW_BROADCAST
+	// line of broadcast set is driven by HAL
+	if ((m_state != OWMHS_IDLE) && (m_broadcast & (1 << channel)))
+		return true;
+#endif
+#endif
+	CRITICAL_REGION_ENTER();
+	report = ((m_hot_plug_armed & (1UL << channel)) != 0);
+	m_hot_plug_armed &= ~(1UL << channel);
+	CRITICAL_REGION_EXIT();
+	if (report)
+		m_hot_plug_handler[channel](channel);
+	return true;
+}
+#define OWMH_IN_INT_BUSY()			owmh_in_int_set(m_in_pin, false)
+#define OWMH_IN_INT_IDLE()			owmh_in_int_set(m_in_pin, true)
+#else
+#define OWMH_IN_INT_BUSY()			((void)0)
+#define OWMH_IN_INT_IDLE()			((void)0)
+#endif
+
+#if ((defined (OW_RESET_EARLY_EXIT)) || (defined (OW_HOT_PLUG)))
+static void owmh_in_edge_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
+{
+	UNUSED_PARAMETER(action);
+	OWMH_ISR_COUNT();
+#ifdef OW_HOT_PLUG
+	if (owmh_hot_plug_edge(pin))
+		return;
+#endif
+#ifdef OW_RESET_EARLY_EXIT
+	if (pin == m_in_pin)
+		owmh_reset_edge();
+#endif
+}
+#define OW_IN_EDGE_HANDLER		owmh_in_edge_handler
+#else
+#define OW_IN_EDGE_HANDLER		NULL
+#endif
+// GPIOTE interrupt of in pins between slots
+#ifdef OW_HOT_PLUG
+#define OW_IN_INT_IDLE			true
+#else
+#define OW_IN_INT_IDLE			false
+#endif
+
+#ifdef OW_LOW_POWER_DELAY
+// Delays and hold power are timed by RTC based app_timer with single wakeup
+// at the end, 1-wire timer is stopped and HFCLK is not requested meanwhile.
+APP_TIMER_DEF(m_ow_delay_timer);
+static void ow_delay_timer_handler(void * p_context);
+
+#define OW_APP_TIMER_TICKS_US(us) \
+	((uint32_t)ROUNDED_DIV((us) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+#endif
+
+#ifdef OW_PREDICTIVE_FLAG_POLL
+static ow_flag_poll_t m_flag_poll;
+#endif
+
+#ifdef OW_SLOT_RETRY
+// Timer is stopped at end of slot by hardware, so late interrupt only prolongs recovery time.
+// But CPU strobe of slot and timer start are not atomic: if they are preempted (SoftDevice),
+// low pulse on line is stretched while timer is stopped. Strobe is timed by cycle counter,
+// slot with stretch beyond tolerance of its pulse is late.
+#define OW_CYCLES_PER_TICK	(SystemCoreClock / 16000000)
+
+static uint32_t   m_strobe_cycles;   // cycles from strobe to timer start, 0 - no strobe
+static uint32_t   m_retry_count;
+
+uint32_t owmh_retry_count(void)
+{
+	return m_retry_count;
+}
+#endif
+
+#ifdef OW_HAL_STAGING
+// Staged sequence. It is started from completion interrupt before callback of master,
+// so bus does not wait for state machine of master between packet phases.
+typedef struct
+{
+	uint8_t*  p_txdata;
+	uint8_t*  p_rxdata;
+	uint16_t  tx_count;
+	uint16_t  rx_count;
+	uint8_t   crc_check;       // CRC8 checking armed for staged sequence
+	bool      armed;
+} owmh_stage_t;
+
+static owmh_stage_t     m_stage;
+static owmh_callback_t  m_stage_callback;  // callback of master
+
+static void owmh_stage_callback(owmh_callback_result_t result)
+{
+	if (m_stage.armed)
+	{
+		m_stage.armed = false;
+		if ((result == OWMHCR_RESET_OK) || (result == OWMHCR_SEQUENCE_OK))
+		{
+#ifdef OW_RX_CRC8
+			owmh_rx_crc_check(m_stage.crc_check);
+#endif
+			owmh_sequence(m_stage.p_txdata, m_stage.p_rxdata, m_stage.tx_count, m_stage.rx_count);
+		}
+	}
+	m_stage_callback(result);
+}
+
+void owmh_sequence_stage(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL((!m_stage.armed) && ((tx_count) || (rx_count)));
+	APP_ERROR_CHECK_BOOL((!OWMH_BROADCAST) || (rx_count == 0));
+	m_stage.p_txdata  = p_txdata;
+	m_stage.p_rxdata  = p_rxdata;
+	m_stage.tx_count  = tx_count;
+	m_stage.rx_count  = rx_count;
+	m_stage.crc_check = 0;
+	m_stage.armed     = true;
+}
+#endif
+
+#ifdef OW_RX_CRC8
+static uint8_t    m_rx_crc8;         // CRC8 of received bytes of current sequence
+static uint8_t    m_rx_crc_check;    // bytes to check, armed for next sequence
+static uint8_t    m_rx_crc_left;     // bytes left to end of checked block
+static bool       m_rx_crc_continue; // next sequence continues CRC8 and checked block
+
+void owmh_rx_crc_check(uint8_t check_count)
+{
+#ifdef OW_HAL_STAGING
+	if (m_stage.armed)
+	{
+		// current operation can be in progress
+		m_stage.crc_check = check_count;
+		return;
+	}
+#endif
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_check = check_count;
+}
+
+void owmh_rx_crc_continue(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_continue = true;
+}
+
+uint8_t owmh_rx_crc8(void)
+{
+	return m_rx_crc8;
+}
+
+// CRC8 update by received byte. False, if checked block is completed with wrong CRC8.
+static bool owmh_rx_crc_byte(uint8_t value)
+{
+	m_rx_crc8 = crc8(m_rx_crc8, value);
+	return ((m_rx_crc_left == 0) || (--m_rx_crc_left > 0) || (m_rx_crc8 == 0));
+}
+#endif
+
+#ifdef OW_TRACE
+// Bus trace. Strobe time and kind of slot are kept until its edge is captured,
+// results are recorded by callback wrapper. Broadcast slots are not recorded.
+#define OW_TRACE_CYCLES_PER_TICK	(OW_TRACE_CLOCK_HZ / OW_TRACE_EDGE_HZ)
+
+static owmh_callback_t  m_trace_callback;  // callback of master
+static uint32_t         m_trace_time;      // strobe of slot (of first slot of engine batch)
+static ow_trace_event_t m_trace_slot;
+static bool             m_trace_pending;   // slot is strobed, edge is not recorded
+
+static void owmh_trace_callback(owmh_callback_result_t result)
+{
+	bool fail = ((result == OWMHCR_ERROR) || (result == OWMHCR_SLOT_LATE) || (result == OWMHCR_CRC_ERROR));
+
+	ow_trace_put(DWT->CYCCNT, result, (fail) ? OW_TRACE_FAIL : OW_TRACE_DONE, m_channel);
+	m_trace_callback(result);
+}
+
+static uint32_t owmh_trace_op(owmh_state_t state)
+{
+	switch (state)
+	{
+	case OWMHS_RESET:      return OW_TRACE_OP_RESET;
+	case OWMHS_WRITE0:
+	case OWMHS_WRITE1:     return OW_TRACE_OP_WRITE;
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_ID: return OW_TRACE_OP_TRIPLET;
+#endif
+	case OWMHS_SEQUENCE:   return OW_TRACE_OP_SEQUENCE;
+	case OWMHS_READ_FLAG:  return OW_TRACE_OP_WAIT_FLAG;
+	case OWMHS_DELAY:      return OW_TRACE_OP_DELAY;
+#ifdef OW_PARASITE_POWER_SUPPORT
+	case OWMHS_POWER_HOLD: return OW_TRACE_OP_HOLD_POWER;
+#endif
+	default:               return OW_TRACE_OP_READ;
+	}
+}
+
+// edge of slot strobed by owmh_continue()
+static void owmh_trace_slot(uint32_t edge)
+{
+	if (m_trace_pending)
+	{
+		m_trace_pending = false;
+		ow_trace_put(m_trace_time, edge, m_trace_slot, m_channel);
+	}
+}
+
+#define OWMH_TRACE_OP(state)		ow_trace_put(DWT->CYCCNT, owmh_trace_op(state), OW_TRACE_OP, m_channel)
+#define OWMH_TRACE_SLOT(edge)		owmh_trace_slot(edge)
+#else
+#define OWMH_TRACE_OP(state)		((void)0)
+#define OWMH_TRACE_SLOT(edge)		((void)0)
+#endif // OW_TRACE
+
+static const nrf_drv_gpiote_out_config_t ow_gpiote_out_config =
+{
+	.action = NRF_GPIOTE_POLARITY_LOTOHI,
+	.init_state = NRF_GPIOTE_INITIAL_VALUE_HIGH,
+	.task_pin = true,
+};
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+// Strong pull-up engaged by hardware at end of last write pulse of sequence (CC1 event):
+//  - out pin: GPIOTE SET task already releases line at CC1, pin drive is switched to S0H1
+//    before sequence, so released line is driven high (only write slots in sequence);
+//  - dedicated power pin: pin is taken by GPIOTE before last slot, CC1 event activates it by PPI.
+static bool m_pullup_armed;     // pull-up armed for next sequence
+static bool m_pullup_hw;        // pull-up engaged (or will be engaged at end of slot) by hardware
+
+#ifdef OW_DEDICATED_POWER_PIN
+static nrf_ppi_channel_t m_ppi_channel_pullup;
+
+#if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
+#define OW_PWR_ON_TASK_ADDR(pin)	nrf_drv_gpiote_set_task_addr_get(pin)
+static const nrf_drv_gpiote_out_config_t ow_gpiote_pwr_config =
+{
+	.action = NRF_GPIOTE_POLARITY_LOTOHI,
+	.init_state = NRF_GPIOTE_INITIAL_VALUE_LOW,
+	.task_pin = true,
+};
+#else
+#define OW_PWR_ON_TASK_ADDR(pin)	nrf_drv_gpiote_clr_task_addr_get(pin)
+static const nrf_drv_gpiote_out_config_t ow_gpiote_pwr_config =
+{
+	.action = NRF_GPIOTE_POLARITY_HITOLO,
+	.init_state = NRF_GPIOTE_INITIAL_VALUE_HIGH,
+	.task_pin = true,
+};
+#endif
+#endif // OW_DEDICATED_POWER_PIN
+#endif
+
+static const nrf_drv_gpiote_in_config_t ow_gpiote_in_config = 
+{
+	.is_watcher = false,
+	.hi_accuracy = true,
+	.pull = NRF_GPIO_PIN_NOPULL,
+	.sense = NRF_GPIOTE_POLARITY_LOTOHI,
+	.skip_gpio_setup = true
+};
+
+static const nrf_drv_timer_config_t ow_timer_cfg =
+{
+	.frequency = NRF_TIMER_FREQ_16MHz,
+	.mode = NRF_TIMER_MODE_TIMER,
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	.bit_width = NRF_TIMER_BIT_WIDTH_32,   // flag polling pauses are longer than 4 ms
+#else
+	.bit_width = NRF_TIMER_BIT_WIDTH_16,
+#endif
+	.interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
+	.p_context = NULL
+};
+
+#ifdef OW_SLOT_ENGINE
+static const nrf_drv_timer_config_t ow_counter_cfg =
+{
+	.frequency = NRF_TIMER_FREQ_16MHz,
+	.mode = NRF_TIMER_MODE_COUNTER,
+	.bit_width = NRF_TIMER_BIT_WIDTH_16,
+	.interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
+	.p_context = NULL
+};
+#endif
+
+#ifdef OW_CHANNEL_PREALLOCATED
+// Switching to preallocated GPIOTE and PPI of channel. Few register writes, no driver calls.
+static void owmh_channel_select(uint8_t channel)
+{
+	const ow_channel_ppi_t* p_ppi = &m_channel_ppi[channel];
+
+	nrf_ppi_group_disable(m_ppi_group_channel);
+#ifdef OW_SLOT_ENGINE
+	nrf_ppi_channel_remove_from_group(m_ppi_channel_strobe_end, m_ppi_group_release1);
+	nrf_ppi_channel_include_in_group(p_ppi->strobe_end, m_ppi_group_release1);
+	m_ppi_channel_strobe   = p_ppi->strobe;
+	m_ppi_channel_release0 = p_ppi->release0;
+#endif
+	m_ppi_channel_capture    = p_ppi->capture;
+	m_ppi_channel_strobe_end = p_ppi->strobe_end;
+	m_ppi_group_channel      = p_ppi->group;
+	nrf_ppi_group_enable(m_ppi_group_channel);
+
+	m_out_pin = ow_pins[channel].tx_pin;
+	m_in_pin  = ow_pins[channel].rx_pin;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	m_pwr_pin = ow_pins[channel].pwr_pin;
+#endif
+}
+
+// GPIOTE and PPI setup for all channels, first channel is selected.
+static void owmh_channels_setup(void)
+{
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		ow_channel_ppi_t* p_ppi = &m_channel_ppi[k];
+		uint32_t out_pin = ow_pins[k].tx_pin;
+		uint32_t in_pin  = ow_pins[k].rx_pin;
+
+		APP_ERROR_CHECK(nrf_drv_gpiote_out_init(out_pin, &ow_gpiote_out_config));
+		APP_ERROR_CHECK(nrf_drv_gpiote_in_init(in_pin, &ow_gpiote_in_config, OW_IN_EDGE_HANDLER));
+		nrf_drv_gpiote_in_event_enable(in_pin, OW_IN_INT_IDLE);
+
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&p_ppi->capture));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(p_ppi->capture,
+			nrf_drv_gpiote_in_event_addr_get(in_pin),
+			nrf_drv_timer_task_address_get(&ow_timer, NRF_TIMER_TASK_CAPTURE0)));
+
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&p_ppi->strobe_end));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(p_ppi->strobe_end,
+			nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE1),
+			nrf_drv_gpiote_set_task_addr_get(out_pin)));
+
+#ifdef OW_SLOT_ENGINE
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_fork_assign(p_ppi->capture,
+			nrf_drv_timer_task_address_get(&ow_counter, NRF_TIMER_TASK_COUNT)));
+
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&p_ppi->strobe));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(p_ppi->strobe,
+			nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE2),
+			nrf_drv_gpiote_clr_task_addr_get(out_pin)));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_fork_assign(p_ppi->strobe,
+			nrf_drv_timer_task_address_get(&ow_counter, NRF_TIMER_TASK_COUNT)));
+
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&p_ppi->release0));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(p_ppi->release0,
+			nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE3),
+			nrf_drv_gpiote_set_task_addr_get(out_pin)));
+#endif
+
+		APP_ERROR_CHECK(nrf_drv_ppi_group_alloc(&p_ppi->group));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_include_in_group(p_ppi->capture, p_ppi->group));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_include_in_group(p_ppi->strobe_end, p_ppi->group));
+
+		nrf_drv_gpiote_out_task_enable(out_pin);
+	}
+
+	m_ppi_channel_strobe_end = m_channel_ppi[OW_GROUP_FIRST_CHANNEL].strobe_end;
+	m_ppi_group_channel      = m_channel_ppi[OW_GROUP_FIRST_CHANNEL].group;
+	owmh_channel_select(OW_GROUP_FIRST_CHANNEL);
+}
+
+static void owmh_channels_release(void)
+{
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		ow_channel_ppi_t* p_ppi = &m_channel_ppi[k];
+
+		nrf_drv_ppi_group_free(p_ppi->group);
+		nrf_drv_ppi_channel_disable(p_ppi->capture);
+		nrf_drv_ppi_channel_disable(p_ppi->strobe_end);
+		nrf_drv_ppi_channel_free(p_ppi->capture);
+		nrf_drv_ppi_channel_free(p_ppi->strobe_end);
+#ifdef OW_SLOT_ENGINE
+		nrf_drv_ppi_channel_disable(p_ppi->strobe);
+		nrf_drv_ppi_channel_disable(p_ppi->release0);
+		nrf_drv_ppi_channel_free(p_ppi->strobe);
+		nrf_drv_ppi_channel_free(p_ppi->release0);
+#endif
+		nrf_drv_gpiote_out_uninit(ow_pins[k].tx_pin);
+		nrf_drv_gpiote_in_uninit(ow_pins[k].rx_pin);
+	}
+}
+#endif // OW_CHANNEL_PREALLOCATED
+
+#ifdef OW_BROADCAST
+// Strobe of all channels of broadcast set. GPIOTE tasks are triggered back to back.
+static void owmh_broadcast_strobe(void)
+{
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		if (m_broadcast & (1 << k))
+			nrfx_gpiote_clr_task_trigger(ow_pins[k].tx_pin);
+	}
+}
+
+// Edges of timeslot. Channels without presence pulse in reset slot or with
+// incorrect write pulse are dropped from set.
+static void owmh_broadcast_edges(void)
 {
-	.action = NRF_GPIOTE_POLARITY_LOTOHI,
-	.init_state = NRF_GPIOTE_INITIAL_VALUE_HIGH,
-	.task_pin = true,
-};
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		uint32_t capture_value;
+		bool     valid;
+
+		if (!(m_broadcast & (1 << k)))
+			continue;
+		capture_value = nrf_drv_timer_capture_get(&ow_timer, broadcast_capture_cc[m_broadcast_cc[k]]);
+		if (m_state == OWMHS_RESET)
+			valid = ((capture_value > OW_PRESENCE_BOUND) && (capture_value <= (OW_RESET_DELAY - 30)));
+		else if (m_tx_bit)
+			valid = ((capture_value >= OW_WRITE1_PULSE) && (capture_value <= (OW_WRITE1_PULSE + OW_WRITE1_PULSE_TOLERANCE)));
+		else
+			valid = ((capture_value >= OW_WRITE0_PULSE) && (capture_value <= (OW_WRITE0_PULSE + OW_WRITE0_PULSE_TOLERANCE)));
+		if (!valid)
+			m_broadcast &= (uint8_t)(~(1 << k));
+	}
+}
 
-static const nrf_drv_gpiote_in_config_t ow_gpiote_in_config = 
+// Channels with line held low are dropped from set
+static void owmh_broadcast_lines(void)
 {
-	.is_watcher = false,
-	.hi_accuracy = true,
-	.pull = NRF_GPIO_PIN_NOPULL,
-	.sense = NRF_GPIOTE_POLARITY_LOTOHI,
-	.skip_gpio_setup = true
-};
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		if ((m_broadcast & (1 << k)) && (!nrf_gpio_pin_read(ow_pins[k].rx_pin)))
+			m_broadcast &= (uint8_t)(~(1 << k));
+	}
+}
 
-static const nrf_drv_timer_config_t ow_timer_cfg =
+uint8_t owmh_broadcast(uint8_t channel_mask)
 {
-	.frequency = NRF_TIMER_FREQ_16MHz,
-	.mode = NRF_TIMER_MODE_TIMER,
-	.bit_width = NRF_TIMER_BIT_WIDTH_16,
-	.interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
-	.p_context = NULL
-};
+	uint8_t completed = m_broadcast;
+	uint8_t count = 0;
+
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	APP_ERROR_CHECK_BOOL((channel_mask & (~OW_BROADCAST_CHANNELS)) == 0);
+
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		const ow_channel_ppi_t* p_ppi = &m_channel_ppi[k];
+		nrf_timer_task_t capture_task = NRF_TIMER_TASK_CAPTURE0;
+
+		if (channel_mask & (1 << k))
+		{
+			APP_ERROR_CHECK_BOOL(count < OW_BROADCAST_MAX);
+			m_broadcast_cc[k] = count;
+			capture_task = broadcast_capture_task[count++];
+		}
+		nrf_ppi_task_endpoint_setup(p_ppi->capture, nrf_drv_timer_task_address_get(&ow_timer, capture_task));
+
+		// out of broadcast only group of current channel is enabled
+		if ((channel_mask & (1 << k)) || ((channel_mask == 0) && (k == m_channel)))
+			nrf_ppi_group_enable(p_ppi->group);
+		else
+			nrf_ppi_group_disable(p_ppi->group);
+	}
+	m_broadcast = channel_mask;
+	return completed;
+}
+#endif // OW_BROADCAST
 
 void owm_hal_initialize(owmh_callback_t callback)
 {
@@ -123,17 +1172,32 @@ void owm_hal_initialize(owmh_callback_t callback)
 	    APP_ERROR_CHECK(NRFX_ERROR_INVALID_STATE);
     }
 
+#ifdef OW_HAL_STAGING
+	m_stage_callback = callback;
+	callback = owmh_stage_callback;
+#endif
+#ifdef OW_TRACE
+	m_trace_callback = callback;
+	m_callback = owmh_trace_callback;
+#else
 	m_callback = callback;
+#endif
 	
+#ifdef OW_LOW_POWER_DELAY
+	// app_timer_init() must be called by application
+	APP_ERROR_CHECK(app_timer_create(&m_ow_delay_timer, APP_TIMER_MODE_SINGLE_SHOT, ow_delay_timer_handler));
+#endif
+
 	// init GPIO
 #ifdef OW_MULTI_CHANNEL
-	m_out_pin = ow_pins[0].tx_pin;
-	m_in_pin  = ow_pins[0].rx_pin;
+	m_channel = OW_GROUP_FIRST_CHANNEL;
+	m_out_pin = ow_pins[OW_GROUP_FIRST_CHANNEL].tx_pin;
+	m_in_pin  = ow_pins[OW_GROUP_FIRST_CHANNEL].rx_pin;
 #if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
-	m_pwr_pin = ow_pins[0].pwr_pin;
+	m_pwr_pin = ow_pins[OW_GROUP_FIRST_CHANNEL].pwr_pin;
 #endif
 	
-	for(uint8_t k = 0 ; k < OW_CHANNEL_COUNT ; ++k)
+	for(uint8_t k = OW_GROUP_FIRST_CHANNEL ; k < OW_GROUP_END_CHANNEL ; ++k)
 	{
 		nrf_gpio_cfg_input(ow_pins[k].rx_pin, NRF_GPIO_PIN_NOPULL);
 		nrf_gpio_pin_set(ow_pins[k].tx_pin);
@@ -194,13 +1258,20 @@ void owm_hal_initialize(owmh_callback_t callback)
 		APP_ERROR_CHECK(nrf_drv_gpiote_init()) ;
 	}
 	
+#ifndef OW_CHANNEL_PREALLOCATED
 	nrf_drv_gpiote_out_init(m_out_pin, &ow_gpiote_out_config);
 	
-	APP_ERROR_CHECK(nrf_drv_gpiote_in_init(m_in_pin, &ow_gpiote_in_config, NULL)) ;
-	nrf_drv_gpiote_in_event_enable(m_in_pin, true);
+	APP_ERROR_CHECK(nrf_drv_gpiote_in_init(m_in_pin, &ow_gpiote_in_config, OW_IN_EDGE_HANDLER)) ;
+	nrf_drv_gpiote_in_event_enable(m_in_pin, OW_IN_INT_IDLE);
+#endif
 	
 	APP_ERROR_CHECK(nrf_drv_timer_init(&ow_timer, &ow_timer_cfg, ow_timer_event_handler)) ; 
 
+#if ((defined (OW_SLOT_RETRY)) || (defined (OW_TRACE)))
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
 	nrf_drv_timer_clear(&ow_timer);
 	
 	nrf_drv_timer_extended_compare(&ow_timer, NRF_TIMER_CC_CHANNEL0, 0, 0, false);
@@ -217,8 +1288,12 @@ void owm_hal_initialize(owmh_callback_t callback)
 		NRF_TIMER_SHORT_COMPARE2_STOP_MASK,
 		true);
 
-	APP_ERROR_CHECK(nrf_drv_ppi_init()) ;
+	// PPI driver can be initialized by other module (or HAL instance of other bus group)
+	ret_code_t err_code = nrf_drv_ppi_init();
+	if (err_code != NRF_ERROR_MODULE_ALREADY_INITIALIZED)
+		APP_ERROR_CHECK(err_code);
 
+#ifndef OW_CHANNEL_PREALLOCATED
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_capture)) ;
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_capture,
 		nrf_drv_gpiote_in_event_addr_get(m_in_pin),
@@ -233,14 +1308,66 @@ void owm_hal_initialize(owmh_callback_t callback)
 
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_capture));
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_strobe_end));
+#endif
 	
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)) && (defined (OW_DEDICATED_POWER_PIN)))
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_pullup));
+#endif
+
+#ifdef OW_SLOT_ENGINE
+	// counter of slot ends and released edges. Runs only while sequence is in progress.
+	APP_ERROR_CHECK(nrf_drv_timer_init(&ow_counter, &ow_counter_cfg, ow_counter_event_handler));
+	nrf_drv_timer_compare(&ow_counter, NRF_TIMER_CC_CHANNEL3, OW_ENGINE_COUNT_NEVER, true);
+
+#ifndef OW_CHANNEL_PREALLOCATED
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_fork_assign(m_ppi_channel_capture,
+		nrf_drv_timer_task_address_get(&ow_counter, NRF_TIMER_TASK_COUNT)));
+
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_strobe));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_strobe,
+		nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE2),
+		nrf_drv_gpiote_clr_task_addr_get(m_out_pin)));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_fork_assign(m_ppi_channel_strobe,
+		nrf_drv_timer_task_address_get(&ow_counter, NRF_TIMER_TASK_COUNT)));
+
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_release0));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_release0,
+		nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE3),
+		nrf_drv_gpiote_set_task_addr_get(m_out_pin)));
+#endif
+
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_batch_end));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_batch_end,
+		nrf_drv_timer_compare_event_address_get(&ow_counter, NRF_TIMER_CC_CHANNEL3),
+		nrf_drv_timer_task_address_get(&ow_timer, NRF_TIMER_TASK_STOP)));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_batch_end));
+
+	for (uint8_t k = 0; k < (OW_ENGINE_SLOTS - 1); ++k)
+	{
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_alloc(&m_ppi_channel_route[k]));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_route[k],
+			nrf_drv_timer_compare_event_address_get(&ow_counter, engine_route_cc[k]),
+			nrf_drv_timer_task_address_get(&ow_timer, engine_capture_task[k])));
+		APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_route[k]));
+	}
+
+	APP_ERROR_CHECK(nrf_drv_ppi_group_alloc(&m_ppi_group_release1));
+#ifndef OW_CHANNEL_PREALLOCATED
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_include_in_group(m_ppi_channel_strobe_end, m_ppi_group_release1));
+#endif
+#endif
+
+#ifdef OW_CHANNEL_PREALLOCATED
+	owmh_channels_setup();
+#else
 	nrf_drv_gpiote_out_task_enable(m_out_pin);
+#endif
 
 	m_state = OWMHS_IDLE;
 }
 
 
-#ifdef OW_MULTI_CHANNEL
+#if ((defined (OW_MULTI_CHANNEL)) && (!defined (OW_CHANNEL_PREALLOCATED)))
 #if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
 uint32_t owmh_ow_change_pins(uint32_t out_pin, uint32_t in_pin, uint32_t pwr_pin)
 #else
@@ -263,8 +1390,8 @@ static uint32_t owmh_ow_change_pins(uint32_t out_pin, uint32_t in_pin)
 
 	nrf_drv_gpiote_out_init(out_pin, &ow_gpiote_out_config);
 	
-	APP_ERROR_CHECK(nrf_drv_gpiote_in_init(in_pin, &ow_gpiote_in_config, NULL)) ;
-	nrf_drv_gpiote_in_event_enable(in_pin, true);
+	APP_ERROR_CHECK(nrf_drv_gpiote_in_init(in_pin, &ow_gpiote_in_config, OW_IN_EDGE_HANDLER)) ;
+	nrf_drv_gpiote_in_event_enable(in_pin, OW_IN_INT_IDLE);
 	
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_capture,
 		nrf_drv_gpiote_in_event_addr_get(in_pin),
@@ -275,6 +1402,11 @@ static uint32_t owmh_ow_change_pins(uint32_t out_pin, uint32_t in_pin)
 		nrf_drv_timer_event_address_get(&ow_timer,
 		NRF_TIMER_EVENT_COMPARE1),
 		nrf_drv_gpiote_set_task_addr_get(out_pin)));
+
+#ifdef OW_SLOT_ENGINE
+	nrf_ppi_task_endpoint_setup(m_ppi_channel_strobe, nrf_drv_gpiote_clr_task_addr_get(out_pin));
+	nrf_ppi_task_endpoint_setup(m_ppi_channel_release0, nrf_drv_gpiote_set_task_addr_get(out_pin));
+#endif
 	
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_capture));
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_strobe_end));
@@ -291,19 +1423,43 @@ uint32_t owm_hal_uninitialize(void)
 	if(m_state != OWMHS_IDLE) return 1;
 	
 	// uninit PPI
+#ifdef OW_CHANNEL_PREALLOCATED
+	owmh_channels_release();
+#else
 	nrf_drv_ppi_channel_disable(m_ppi_channel_capture);
 	nrf_drv_ppi_channel_disable(m_ppi_channel_strobe_end);
 	nrf_drv_ppi_channel_free(m_ppi_channel_capture);	
 	nrf_drv_ppi_channel_free(m_ppi_channel_strobe_end);	
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)) && (defined (OW_DEDICATED_POWER_PIN)))
+	nrf_drv_ppi_channel_free(m_ppi_channel_pullup);
+#endif
+#ifdef OW_SLOT_ENGINE
+	nrf_drv_ppi_group_free(m_ppi_group_release1);
+	nrf_drv_ppi_channel_disable(m_ppi_channel_batch_end);
+#ifndef OW_CHANNEL_PREALLOCATED
+	nrf_drv_ppi_channel_free(m_ppi_channel_strobe);
+	nrf_drv_ppi_channel_free(m_ppi_channel_release0);
+#endif
+	nrf_drv_ppi_channel_free(m_ppi_channel_batch_end);
+	for (uint8_t k = 0; k < (OW_ENGINE_SLOTS - 1); ++k)
+	{
+		nrf_drv_ppi_channel_disable(m_ppi_channel_route[k]);
+		nrf_drv_ppi_channel_free(m_ppi_channel_route[k]);
+	}
+	nrf_drv_timer_uninit(&ow_counter);
+#endif
 	// uninit TIMER	
 	nrf_drv_timer_uninit(&ow_timer);
 	// uninit GPIOTE
+#ifndef OW_CHANNEL_PREALLOCATED
 	nrf_drv_gpiote_out_uninit(m_out_pin);
 	nrf_drv_gpiote_in_uninit(m_in_pin);
+#endif
 	/* Reset pins to default states */
 	
 #ifdef OW_MULTI_CHANNEL 
-	for (uint8_t k = 0; k < OW_CHANNEL_COUNT; ++k)
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
 	{
 		nrf_gpio_cfg_default(ow_pins[k].tx_pin);
 		nrf_gpio_cfg_default(ow_pins[k].rx_pin);
@@ -328,16 +1484,81 @@ void ow_set_channel(uint8_t channel)
 {
 	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
 
+#ifdef OW_CHANNEL_PREALLOCATED
+	if (m_channel != channel)
+		owmh_channel_select(channel);
+	m_channel = channel;
+#else
+	m_channel = channel;
 	if (m_out_pin != ow_pins[channel].tx_pin)
 #if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
 		owmh_ow_change_pins(ow_pins[channel].tx_pin, ow_pins[channel].rx_pin, ow_pins[channel].pwr_pin);
 #else
 		owmh_ow_change_pins(ow_pins[channel].tx_pin, ow_pins[channel].rx_pin);
 #endif
+#endif
 }
 #endif // (defined (OW_MULTI_CHANNEL))
 
 #ifdef OW_PARASITE_POWER_SUPPORT
+#ifdef OW_HW_STRONG_PULLUP
+// Preparation of next timeslot of armed sequence
+static void owmh_pullup_slot(void)
+{
+	if ((!m_pullup_armed) || (m_pullup_hw))
+		return;
+#ifdef OW_DEDICATED_POWER_PIN
+	// power pin is activated at end of last slot only
+	if (m_tx_count > 1)
+		return;
+	nrf_drv_gpiote_out_init(m_pwr_pin, &ow_gpiote_pwr_config);
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_pullup,
+		nrf_drv_timer_event_address_get(&ow_timer, NRF_TIMER_EVENT_COMPARE1),
+		OW_PWR_ON_TASK_ADDR(m_pwr_pin)));
+	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_pullup));
+	nrf_drv_gpiote_out_task_enable(m_pwr_pin);
+#else
+	// released line is driven high in all write slots of sequence
+	nrf_gpio_cfg(m_out_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_S0H1,
+		NRF_GPIO_PIN_NOSENSE);
+#endif
+	m_pullup_hw = true;
+}
+
+// Release of pull-up engaged by hardware
+static void owmh_pullup_release(void)
+{
+	m_pullup_armed = false;
+	if (!m_pullup_hw)
+		return;
+	m_pullup_hw = false;
+#ifdef OW_DEDICATED_POWER_PIN
+	nrf_drv_ppi_channel_disable(m_ppi_channel_pullup);
+	nrf_drv_gpiote_out_task_disable(m_pwr_pin);
+	nrf_drv_gpiote_out_uninit(m_pwr_pin);
+#if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
+	nrf_gpio_pin_clear(m_pwr_pin);
+#else
+	nrf_gpio_pin_set(m_pwr_pin);
+#endif
+#else
+	nrf_gpio_cfg(m_out_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_S0D1,
+		NRF_GPIO_PIN_NOSENSE);
+#endif
+}
+#define OWMH_PULLUP_SLOT()		owmh_pullup_slot()
+#else
+#define OWMH_PULLUP_SLOT()		((void)0)
+#endif // OW_HW_STRONG_PULLUP
+
 static void ow_power_on()
 {
 #ifdef OW_DEDICATED_POWER_PIN
@@ -349,7 +1570,9 @@ static void ow_power_on()
 #else
 	nrf_drv_gpiote_out_task_disable(m_out_pin);
 	nrf_drv_ppi_channel_disable(m_ppi_channel_strobe_end);
+#ifndef OW_CHANNEL_PREALLOCATED
 	nrf_drv_gpiote_out_uninit(m_out_pin);
+#endif
 	nrf_gpio_cfg(m_out_pin,
 		NRF_GPIO_PIN_DIR_OUTPUT,
 		NRF_GPIO_PIN_INPUT_DISCONNECT,
@@ -361,6 +1584,13 @@ static void ow_power_on()
 
 static void ow_power_off()
 {
+#ifdef OW_HW_STRONG_PULLUP
+	if (m_pullup_hw)
+	{
+		owmh_pullup_release();
+		return;
+	}
+#endif
 #ifdef OW_DEDICATED_POWER_PIN
 #if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
 	nrf_gpio_pin_clear(m_pwr_pin);
@@ -374,48 +1604,518 @@ static void ow_power_off()
 		NRF_GPIO_PIN_NOPULL,
 		NRF_GPIO_PIN_S0D1,
 		NRF_GPIO_PIN_NOSENSE);
+#ifndef OW_CHANNEL_PREALLOCATED
+	// GPIOTE channel and its task addresses can differ after reinit
 	nrf_drv_gpiote_out_init(m_out_pin, &ow_gpiote_out_config);
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_assign(m_ppi_channel_strobe_end,
 		nrf_drv_timer_event_address_get(&ow_timer,
 			NRF_TIMER_EVENT_COMPARE1),
 		nrf_drv_gpiote_set_task_addr_get(m_out_pin)));
+#endif
 	APP_ERROR_CHECK(nrf_drv_ppi_channel_enable(m_ppi_channel_strobe_end));
 	nrf_drv_gpiote_out_task_enable(m_out_pin);
 #endif
-}
-#endif // (defined (OW_PARASITE_POWER_SUPPORT))
+}
+
+#ifdef OW_BROADCAST
+// Power switching of broadcast set. Pins of every channel are made current
+// for ow_power_on/off(), then pins of current channel are restored.
+static void owmh_broadcast_power(bool on)
+{
+	for (uint8_t k = OW_GROUP_FIRST_CHANNEL; k < OW_GROUP_END_CHANNEL; ++k)
+	{
+		if (!(m_broadcast & (1 << k)))
+			continue;
+		m_out_pin = ow_pins[k].tx_pin;
+#ifdef OW_DEDICATED_POWER_PIN
+		m_pwr_pin = ow_pins[k].pwr_pin;
+#endif
+		m_ppi_channel_strobe_end = m_channel_ppi[k].strobe_end;
+		if (on)
+			ow_power_on();
+		else
+			ow_power_off();
+	}
+	m_out_pin = ow_pins[m_channel].tx_pin;
+#ifdef OW_DEDICATED_POWER_PIN
+	m_pwr_pin = ow_pins[m_channel].pwr_pin;
+#endif
+	m_ppi_channel_strobe_end = m_channel_ppi[m_channel].strobe_end;
+}
+#endif
+#endif // (defined (OW_PARASITE_POWER_SUPPORT))
+
+#ifdef OW_SLOT_EARLY_END
+// Early end of data slots. Slot is finished by CC2 at expected release edge + recovery
+// time, but not before minimal timeslot. If edge was captured later (slow rising edge,
+// device holding line), slot is prolonged up to recovery after it, but not beyond full
+// slot delay. Line still low at early end waits full delay and is validated as usual.
+#define OW_SLOT_RECOVERY		DELAY_MKS(OW_SLOT_EARLY_END)
+#ifdef OW_OVERDRIVE_SUPPORT
+#define OW_SLOT_MIN				((m_overdrive) ? DELAY_MKS(7) : DELAY_MKS(61))
+#else
+#define OW_SLOT_MIN				DELAY_MKS(61)
+#endif
+
+static uint32_t   m_slot_early;      // early end of current slot
+static uint32_t   m_slot_delay;      // full delay of current slot
+
+static uint32_t owmh_slot_early(uint32_t pulse, uint32_t delay)
+{
+	uint32_t early = pulse + OW_SLOT_RECOVERY +
+		((pulse == OW_WRITE0_PULSE) ? OW_WRITE0_PULSE_TOLERANCE : OW_WRITE1_PULSE_TOLERANCE);
+
+	if (early < OW_SLOT_MIN)
+		early = OW_SLOT_MIN;
+	return (early < delay) ? early : delay;
+}
+
+// Slot prolongation on early end. True, if timer is resumed.
+static bool owmh_slot_extend(void)
+{
+	uint32_t end;
+
+	if (m_slot_early >= m_slot_delay)
+		return false;
+	end = nrf_drv_timer_capture_get(&ow_timer, NRF_TIMER_CC_CHANNEL0) + OW_SLOT_RECOVERY;
+	if (!nrf_gpio_pin_read(m_in_pin))
+		end = m_slot_delay;
+	if (end <= m_slot_early)
+		return false;
+	if (end > m_slot_delay)
+		end = m_slot_delay;
+	OWMH_ACTIVE_TICKS(end - m_slot_early);
+	m_slot_early = m_slot_delay;
+	nrf_drv_timer_compare(&ow_timer, NRF_TIMER_CC_CHANNEL2, end, true);
+	nrf_drv_timer_resume(&ow_timer);
+	return true;
+}
+#endif
+
+static void owmh_continue(uint32_t pulse, uint32_t delay)
+{
+#ifdef OW_SLOT_RETRY
+	uint32_t strobe_cycles = 0;
+#endif
+#ifdef OW_SLOT_EARLY_END
+	m_slot_delay = delay;
+	if ((m_state > OWMHS_RESET) && (m_state < OWMHS_FLAG_PAUSE) && (!OWMH_BROADCAST))
+		delay = owmh_slot_early(pulse, delay);
+	m_slot_early = delay;
+#endif
+#ifdef OW_RESET_EARLY_EXIT
+	if ((m_state == OWMHS_RESET) && (!OWMH_BROADCAST))
+		owmh_in_int_set(m_in_pin, true);
+#endif
+	OWMH_ACTIVE_TICKS(delay);
+	nrf_drv_timer_clear(&ow_timer);
+	nrfx_timer_capture(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+#ifdef OW_BROADCAST
+	for (uint8_t k = 1; (m_broadcast) && (k < OW_BROADCAST_MAX); ++k)
+		nrfx_timer_capture(&ow_timer, broadcast_capture_cc[k]);
+#endif
+
+	nrf_drv_timer_compare(&ow_timer,
+		NRF_TIMER_CC_CHANNEL1,
+		pulse,
+		false);
+	nrf_drv_timer_compare(&ow_timer,
+		NRF_TIMER_CC_CHANNEL2,
+		delay,
+		true);
+
+#ifdef OW_TRACE
+	m_trace_pending = (m_state < OWMHS_FLAG_PAUSE);
+	m_trace_slot = (m_state == OWMHS_RESET) ? OW_TRACE_RESET
+		: ((pulse == OW_WRITE0_PULSE) ? OW_TRACE_WRITE0 : OW_TRACE_SLOT1);
+#endif
+	if (m_state < OWMHS_FLAG_PAUSE)
+	{
+#ifdef OW_SLOT_RETRY
+		strobe_cycles = DWT->CYCCNT;
+#endif
+#ifdef OW_TRACE
+		m_trace_time = DWT->CYCCNT;
+#endif
+#ifdef OW_BROADCAST
+		if (m_broadcast)
+			owmh_broadcast_strobe();
+		else
+#endif
+		nrfx_gpiote_clr_task_trigger(m_out_pin); 
+	}
+	nrf_drv_timer_resume(&ow_timer);
+#ifdef OW_SLOT_RETRY
+	m_strobe_cycles = (m_state < OWMHS_FLAG_PAUSE) ? (DWT->CYCCNT - strobe_cycles) : 0;
+#endif
+}
+
+#ifdef OW_SLOT_RETRY
+// Strobe of slot was stretched beyond tolerance of its pulse
+static bool owmh_slot_late(void)
+{
+	uint32_t tolerance = OW_WRITE1_PULSE_TOLERANCE;    // read and write 1 pulses
+	bool     write = ((m_state == OWMHS_WRITE0) || ((m_state == OWMHS_SEQUENCE) && (m_tx_count > 0)));
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+	write = ((write) || (m_state == OWMHS_TRIPLET_DIR));
+#endif
+	if (m_strobe_cycles == 0)
+		return false;
+	if (m_state == OWMHS_RESET)
+		tolerance = OW_PRESENCE_BOUND - OW_RESET_PULSE;
+	else if ((write) && (!m_tx_bit))
+		tolerance = OW_WRITE0_PULSE;                   // write 0 pulse may be up to doubled
+	return (m_strobe_cycles > (tolerance * OW_CYCLES_PER_TICK));
+}
+
+// Late slot handling. Reset and flag reading slots are re-issued, other slots shift
+// bit stream of devices, so packet is restarted by master.
+// Returns false, if slot is not late.
+static bool owmh_slot_retry(void)
+{
+	bool released;
+
+	if (!owmh_slot_late())
+		return false;
+	++m_retry_count;
+	OWMH_FAULT(OWMH_FAULT_LATE);
+#ifdef OW_BROADCAST
+	if (m_broadcast)
+	{
+		owmh_broadcast_lines();
+		released = (m_broadcast != 0);
+	}
+	else
+#endif
+	released = nrf_gpio_pin_read(m_in_pin);
+
+	if ((released) && (m_state == OWMHS_RESET))
+		owmh_continue(OW_RESET_PULSE, OW_RESET_DELAY);
+	else if ((released) && (m_state == OWMHS_READ_FLAG))
+		owmh_continue(OW_READ_PULSE, OW_READ_TIMESLOT_DELAY);
+	else
+	{
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		owmh_pullup_release();
+#endif
+		m_state = OWMHS_IDLE;
+		OWMH_IN_INT_IDLE();
+		m_callback((released) ? OWMHCR_SLOT_LATE : OWMHCR_ERROR);
+	}
+	return true;
+}
+#endif // OW_SLOT_RETRY
+
+#ifdef OW_SLOT_ENGINE
+// Slot engine. Timeslots of sequence are chained by hardware in batches:
+//  - end of slot (COMPARE2 with CLEAR short) strobes next slot through PPI;
+//  - counter timer counts slot ends and released edges, its compare events route edges
+//    of batch to capture registers CC3..CC5, last edge is captured to CC0 as usual;
+//  - counter compare on last edge of batch stops the timer and invokes the only interrupt.
+// End of write 1 pulse (CC1) is switched for the next slot by PPI group on every edge,
+// end of write 0 pulse (CC3) is always active in write batches.
+
+static inline uint8_t owmh_buf_bit(uint8_t const* p_buf, uint16_t index)
+{
+	return (p_buf[index >> 3] >> (index & 0x07)) & 1;
+}
+
+// Next batch programming. 1-wire timer must be stopped.
+static void owmh_engine_program(void)
+{
+	uint16_t left = (m_tx_count) ? m_tx_count : m_rx_count;
+	uint8_t  slots = (m_tx_count) ? OW_ENGINE_TX_SLOTS : OW_ENGINE_SLOTS;
+	uint32_t period;
+
+	m_batch_tx    = (m_tx_count > 0);
+	m_batch_count = (left > slots) ? slots : (uint8_t)left;
+	OWMH_ACTIVE_TICKS(((m_batch_tx) ? OW_WRITE_TIMESLOT_DELAY : OW_READ_TIMESLOT_DELAY) * m_batch_count);
+
+	nrf_drv_timer_clear(&ow_counter);
+	for (uint8_t k = 0; k < (OW_ENGINE_SLOTS - 1); ++k)
+	{
+		if ((k + 1) >= m_batch_count)
+		{
+			// edge is last in batch or out of batch
+			nrf_drv_timer_compare(&ow_counter, engine_route_cc[k], OW_ENGINE_COUNT_NEVER, false);
+			continue;
+		}
+		// counts: end of previous slot, edge of slot 0, end of slot 0, edge of slot 1...
+		nrf_drv_timer_compare(&ow_counter, engine_route_cc[k], 2 * k + 2, false);
+		if (m_batch_tx)
+		{
+			// edge of slot selects end of pulse for next slot, CC3 is busy by write 0 pulse
+			nrf_ppi_task_endpoint_setup(m_ppi_channel_route[k],
+				(owmh_buf_bit(m_p_tx_buf, m_engine_index + k + 1))
+				? nrf_drv_ppi_task_addr_group_enable_get(m_ppi_group_release1)
+				: nrf_drv_ppi_task_addr_group_disable_get(m_ppi_group_release1));
+			nrf_ppi_fork_endpoint_setup(m_ppi_channel_route[k],
+				nrf_drv_timer_task_address_get(&ow_timer, engine_capture_task[k + 1]));
+		}
+		else
+		{
+			nrf_ppi_task_endpoint_setup(m_ppi_channel_route[k],
+				nrf_drv_timer_task_address_get(&ow_timer, engine_capture_task[k]));
+			nrf_ppi_fork_endpoint_setup(m_ppi_channel_route[k], 0);
+		}
+	}
+	nrf_drv_timer_compare(&ow_counter, NRF_TIMER_CC_CHANNEL3, 2 * m_batch_count, true);
+
+	if (m_batch_tx)
+	{
+		if (owmh_buf_bit(m_p_tx_buf, m_engine_index))
+			nrf_drv_ppi_group_enable(m_ppi_group_release1);
+		else
+			nrf_drv_ppi_group_disable(m_ppi_group_release1);
+		nrf_drv_timer_compare(&ow_timer, NRF_TIMER_CC_CHANNEL3, OW_WRITE0_PULSE, false);
+		nrf_drv_ppi_channel_enable(m_ppi_channel_release0);
+		period = OW_WRITE_TIMESLOT_DELAY;
+	}
+	else
+	{
+		nrf_drv_ppi_group_enable(m_ppi_group_release1);
+		nrf_drv_ppi_channel_disable(m_ppi_channel_release0);
+		period = OW_READ_TIMESLOT_DELAY;
+	}
+	nrf_drv_timer_extended_compare(&ow_timer,
+		NRF_TIMER_CC_CHANNEL2,
+		period,
+		NRF_TIMER_SHORT_COMPARE2_CLEAR_MASK,
+		false);
+}
+
+static void owmh_engine_start(void)
+{
+	m_engine_index = 0;
+	m_state = OWMHS_SEQUENCE;
+
+	nrf_drv_timer_clear(&ow_timer);
+	nrfx_timer_capture(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+	nrf_drv_timer_compare(&ow_timer, NRF_TIMER_CC_CHANNEL1, OW_READ_PULSE, false);
+	owmh_engine_program();
+
+	nrf_drv_timer_resume(&ow_counter);
+	// first slot is strobed by CPU, count it as previous slot end
+	nrf_timer_task_trigger(ow_counter.p_reg, NRF_TIMER_TASK_COUNT);
+	nrf_drv_ppi_channel_enable(m_ppi_channel_strobe);
+
+#ifdef OW_SLOT_RETRY
+	// only first slot is strobed by CPU
+	m_tx_bit = ((m_tx_count == 0) || (owmh_buf_bit(m_p_tx_buf, 0)));
+	m_strobe_cycles = DWT->CYCCNT;
+#endif
+#ifdef OW_TRACE
+	// strobes of next slots are derived from slot period
+	m_trace_pending = false;
+	m_trace_time = DWT->CYCCNT;
+#endif
+	nrfx_gpiote_clr_task_trigger(m_out_pin);
+	nrf_drv_timer_resume(&ow_timer);
+#ifdef OW_SLOT_RETRY
+	m_strobe_cycles = DWT->CYCCNT - m_strobe_cycles;
+#endif
+}
+
+// Returning timer to single timeslot mode. 1-wire timer must be stopped.
+static void owmh_engine_stop(bool wait_slot_end)
+{
+	nrf_drv_ppi_channel_disable(m_ppi_channel_strobe);
+	nrf_drv_ppi_channel_disable(m_ppi_channel_release0);
+	nrf_drv_ppi_group_enable(m_ppi_group_release1);
+	nrf_drv_timer_pause(&ow_counter);
+
+	nrf_drv_timer_extended_compare(&ow_timer,
+		NRF_TIMER_CC_CHANNEL2,
+		(m_batch_tx) ? OW_WRITE_TIMESLOT_DELAY : OW_READ_TIMESLOT_DELAY,
+		NRF_TIMER_SHORT_COMPARE2_STOP_MASK,
+		wait_slot_end);
+	if (wait_slot_end)
+	{
+		// recovery time of last timeslot
+		m_state = OWMHS_SEQUENCE_TAIL;
+		nrf_drv_timer_resume(&ow_timer);
+	}
+}
+
+#ifdef OW_TRACE
+// slot k of batch, edge of slot
+static void owmh_trace_engine_slot(uint8_t k, uint32_t edge)
+{
+	uint32_t period = (m_batch_tx) ? OW_WRITE_TIMESLOT_DELAY : OW_READ_TIMESLOT_DELAY;
+	ow_trace_event_t slot = OW_TRACE_SLOT1;
+
+	if ((m_batch_tx) && (!owmh_buf_bit(m_p_tx_buf, m_engine_index + k)))
+		slot = OW_TRACE_WRITE0;
+	ow_trace_put(m_trace_time + k * period * OW_TRACE_CYCLES_PER_TICK, edge, slot, m_channel);
+	if ((k + 1) == m_batch_count)
+		m_trace_time += m_batch_count * period * OW_TRACE_CYCLES_PER_TICK;
+}
+#define OWMH_TRACE_ENGINE_SLOT(k, edge)	owmh_trace_engine_slot((k), (edge))
+#else
+#define OWMH_TRACE_ENGINE_SLOT(k, edge)	((void)0)
+#endif
+
+// counter interrupt handler (on last edge of batch). 1-wire timer is stopped.
+static void ow_counter_event_handler(nrf_timer_event_t event_type, void * p_context)
+{
+	UNUSED_PARAMETER(event_type);	
+	UNUSED_PARAMETER(p_context);	
+	uint32_t capture_value;
+	uint8_t  mask;
+	uint8_t* p_byte;
+	bool     error = false;
+#ifdef OW_RX_CRC8
+	bool     crc_error = false;
+#endif
+
+	OWMH_ISR_COUNT();
+#ifdef OW_SLOT_RETRY
+	if (owmh_slot_late())
+	{
+		// first slot of sequence was stretched
+		++m_retry_count;
+		OWMH_FAULT(OWMH_FAULT_LATE);
+		owmh_engine_stop(false);
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		owmh_pullup_release();
+#endif
+		m_state = OWMHS_IDLE;
+		OWMH_IN_INT_IDLE();
+		m_callback(OWMHCR_SLOT_LATE);
+		return;
+	}
+	m_strobe_cycles = 0;
+#endif
+	for (uint8_t k = 0; (k < m_batch_count) && (!error); ++k)
+	{
+		if ((k + 1) == m_batch_count)
+			capture_value = nrf_drv_timer_capture_get(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+		else if (!m_batch_tx)
+			capture_value = nrf_drv_timer_capture_get(&ow_timer, engine_capture_cc[k]);
+		else
+			capture_value = nrf_drv_timer_capture_get(&ow_timer, engine_capture_cc[k + 1]);
+		OWMH_TRACE_ENGINE_SLOT(k, capture_value);
+
+		if (m_batch_tx)
+		{
+			// Check if transmitted bit is not corrupted
+			uint32_t strobe = (owmh_buf_bit(m_p_tx_buf, m_engine_index + k)) ? OW_WRITE1_PULSE : OW_WRITE0_PULSE;
+			uint32_t tolerance = (strobe == OW_WRITE1_PULSE) ? OW_WRITE1_PULSE_TOLERANCE : OW_WRITE0_PULSE_TOLERANCE;
+			error = ((capture_value < strobe) || (capture_value > (strobe + tolerance)));
+			if (!error)
+			{
+				OWMH_CALIB_RISE(strobe, capture_value);
+				OWMH_HIST_WRITE(strobe == OW_WRITE1_PULSE, capture_value);
+			}
+		}
+		else
+		{
+			if ((capture_value < OW_WRITE1_PULSE) || (capture_value > (OW_READ_TIMESLOT_DELAY - 30))
+					|| ((capture_value > OW_READ1_BOUND) && (capture_value < OW_READ0_BOUND)))
+			{
+				error = true;
+				break;
+			}
+			p_byte = m_p_rx_buf + ((m_engine_index + k) >> 3);
+			mask   = 1 << ((m_engine_index + k) & 0x07);
+			if (capture_value < OW_READ1_BOUND)
+			{
+				OWMH_CALIB_RISE(OW_READ_PULSE, capture_value);
+				OWMH_HIST_READ1(capture_value);
+				*p_byte |= mask;
+			}
+			else
+			{
+				OWMH_CALIB_READ0(capture_value);
+				OWMH_HIST_READ0(capture_value);
+				*p_byte &= (~mask);
+			}
+#ifdef OW_RX_CRC8
+			// byte completed. Rest of sequence is not transferred, if its CRC8 check fails
+			if ((mask == 0x80) && (!owmh_rx_crc_byte(*p_byte)))
+			{
+				crc_error = error = true;
+				break;
+			}
+#endif
+		}
+	}
 
-static void owmh_continue(uint32_t pulse, uint32_t delay)
-{
-	nrf_drv_timer_clear(&ow_timer);
-	nrfx_timer_capture(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+	if (!error)
+	{
+		m_engine_index += m_batch_count;
+		if (m_batch_tx)
+		{
+			m_tx_count -= m_batch_count;
+			if (m_tx_count == 0)
+				m_engine_index = 0;
+		}
+		else
+			m_rx_count -= m_batch_count;
 
-	nrf_drv_timer_compare(&ow_timer,
-		NRF_TIMER_CC_CHANNEL1,
-		pulse,
-		false);
-	nrf_drv_timer_compare(&ow_timer,
-		NRF_TIMER_CC_CHANNEL2,
-		delay,
-		true);
+		if ((m_tx_count > 0) || (m_rx_count > 0))
+		{
+			// end of current timeslot strobes first slot of next batch
+			owmh_engine_program();
+			nrf_drv_timer_resume(&ow_timer);
+			return;
+		}
+	}
 
-	if (m_state < OWMHS_FLAG_PAUSE)
+	owmh_engine_stop(!error);
+#ifdef OW_RX_CRC8
+	if (crc_error)
 	{
-		nrfx_gpiote_clr_task_trigger(m_out_pin); 
+		m_state = OWMHS_IDLE;
+		OWMH_IN_INT_IDLE();
+		m_callback(OWMHCR_CRC_ERROR);
+	}
+	else
+#endif
+	if (error)
+	{
+		OWMH_CALIB_ERROR();
+		OWMH_FAULT_SLOT();
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		owmh_pullup_release();
+#endif
+		m_state = OWMHS_IDLE;
+		OWMH_IN_INT_IDLE();
+		m_callback(OWMHCR_ERROR);
 	}
-	nrf_drv_timer_resume(&ow_timer);
 }
+#endif // OW_SLOT_ENGINE
 
 static void owmh_start(owmh_state_t state)
 {
 	uint32_t pulse = 0; 
 	uint32_t delay = 0;
 	
+	OWMH_TRACE_OP(state);
+#ifdef OW_BROADCAST
+	if (m_broadcast)
+	{
+		// reset, writing sequences and delays only
+		APP_ERROR_CHECK_BOOL((state == OWMHS_RESET) || (state == OWMHS_SEQUENCE) || (state >= OWMHS_DELAY));
+		owmh_broadcast_lines();
+		if (!m_broadcast)
+		{
+			m_callback(OWMHCR_ERROR);
+			return;
+		}
+	}
+	else
+#endif
 	if (!nrf_gpio_pin_read(m_in_pin))
 	{
+		OWMH_FAULT(OWMH_FAULT_SHORT);
 		m_callback(OWMHCR_ERROR);
 		return;
 	}
+	else
+		OWMH_FAULT_RELEASED();
+	OWMH_IN_INT_BUSY();
 
 	switch (state)
 	{
@@ -437,11 +2137,29 @@ static void owmh_start(owmh_state_t state)
 		break;
 
 	case OWMHS_READ:
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_ID:
+#endif
 		pulse = OW_READ_PULSE;
 		delay = OW_READ_TIMESLOT_DELAY;
 		break;
 
 	case OWMHS_SEQUENCE:
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		OWMH_PULLUP_SLOT();
+#endif
+#ifdef OW_SLOT_ENGINE
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)) && (defined (OW_DEDICATED_POWER_PIN)))
+		// power pin must be armed in last slot, sequence is processed slot by slot
+		if (!m_pullup_armed)
+#endif
+		// spare CC registers capture edges of broadcast set
+		if (!OWMH_BROADCAST)
+		{
+			owmh_engine_start();
+			return;
+		}
+#endif
 		m_tx_bit = ((m_tx_count == 0) || ((*(m_p_tx_buf) & 1)));
 		pulse = (m_tx_bit) ? OW_READ_PULSE : OW_WRITE0_PULSE;
 		delay = (m_tx_count) ? OW_WRITE_TIMESLOT_DELAY : OW_READ_TIMESLOT_DELAY;
@@ -455,12 +2173,14 @@ static void owmh_start(owmh_state_t state)
 		break;
 
 	case OWMHS_DELAY:
-		pulse = OW_MILLISECOND_DELAY + 10;
-		delay = OW_MILLISECOND_DELAY;
-		break;
-
 #if (defined (OW_PARASITE_POWER_SUPPORT))
 	case OWMHS_POWER_HOLD:
+#endif
+#ifdef OW_LOW_POWER_DELAY
+		m_state = state;
+		APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, APP_TIMER_TICKS(m_delay_counter), NULL));
+		return;
+#else
 		pulse = OW_MILLISECOND_DELAY + 10;
 		delay = OW_MILLISECOND_DELAY;
 		break;
@@ -474,9 +2194,33 @@ static void owmh_start(owmh_state_t state)
 	owmh_continue(pulse, delay);
 }
 
+// Timing of current channel and bus speed
+static void owmh_timing_select(void)
+{
+#ifdef OW_OVERDRIVE_SUPPORT
+	if (m_overdrive)
+	{
+		m_p_timing = &ow_timing_overdrive;
+		return;
+	}
+#endif
+#ifdef OW_BUS_CALIBRATION
+	// calibration is per channel, broadcast set uses profile of current channel
+	if ((m_calib[m_channel].request) && (!OWMH_BROADCAST))
+		owmh_calib_apply(m_channel);
+	if ((m_calib[m_channel].active) && (!OWMH_BROADCAST))
+	{
+		m_p_timing = &m_calib[m_channel].timing;
+		return;
+	}
+#endif
+	m_p_timing = &ow_timing_profiles[m_channel_profile[m_channel]];
+}
+
 void owmh_reset(void)
 {
 	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	owmh_timing_select();
 	owmh_start(OWMHS_RESET);
 }
 
@@ -495,22 +2239,91 @@ void owmh_write(uint8_t bit)
 		owmh_start(OWMHS_WRITE0);
 }
 
-void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint8_t  tx_count, uint8_t  rx_count)
+#ifdef OW_ROM_SEARCH_SUPPORT
+void owmh_triplet(uint8_t direction)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_triplet = (direction) ? OWMH_TRIPLET_DIR : 0;
+	owmh_start(OWMHS_TRIPLET_ID);
+}
+#endif
+
+void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
 {
 	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	APP_ERROR_CHECK_BOOL((!OWMH_BROADCAST) || (rx_count == 0));
 	if ((!tx_count)&&(!rx_count)) return;
 	m_p_tx_buf = p_txdata;
 	m_p_rx_buf = p_rxdata;
 	m_tx_count = tx_count;
 	m_rx_count = rx_count;
 	m_byte_mask = 1;
+#ifdef OW_RX_CRC8
+	if (!m_rx_crc_continue)
+	{
+		m_rx_crc8 = 0;
+		m_rx_crc_left = m_rx_crc_check;
+	}
+	m_rx_crc_continue = false;
+	m_rx_crc_check = 0;
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	// devices drive line in read slots, pull-up can be engaged after write only sequences
+	if ((rx_count) || (!tx_count))
+		m_pullup_armed = false;
+#endif
 	owmh_start(OWMHS_SEQUENCE);
 }
 
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+void owmh_arm_power(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	// broadcast set is powered by owmh_hold_power()
+	m_pullup_armed = !OWMH_BROADCAST;
+}
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+void owmh_set_speed(bool overdrive)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_overdrive = overdrive;
+	owmh_timing_select();
+}
+#endif
+
+void owmh_set_profile(uint8_t channel, owmh_profile_t profile)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_PROFILE_CHANNELS) && (profile < OWMH_PROFILE_COUNT));
+	// takes effect from next reset on the channel
+	m_channel_profile[channel] = profile;
+#ifdef OW_BUS_CALIBRATION
+	m_calib[channel].active = false;
+#endif
+}
+
+#ifdef OW_BUS_CALIBRATION
+void owmh_calibrate(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_PROFILE_CHANNELS);
+	m_calib[channel].request = true;
+}
+
+bool owmh_calibrated(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_PROFILE_CHANNELS);
+	return m_calib[channel].active;
+}
+#endif
+
 void owmh_wait_flag(uint16_t max_wait_ms)
 {
 	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
 	m_delay_counter = max_wait_ms;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	ow_flag_poll_init(&m_flag_poll, max_wait_ms);
+#endif
 	owmh_start(OWMHS_READ_FLAG);
 }
 
@@ -526,11 +2339,104 @@ void owmh_hold_power(uint16_t delay_ms)
 {
 	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
 	m_delay_counter = delay_ms;
+#ifdef OW_HW_STRONG_PULLUP
+	// pull-up can be already engaged at end of last sequence
+	m_pullup_armed = false;
+#endif
+#ifdef OW_BROADCAST
+	if (m_broadcast)
+		owmh_broadcast_power(true);
+	else
+#endif
+#ifdef OW_HW_STRONG_PULLUP
+	if (!m_pullup_hw)
+#endif
 	ow_power_on();
 	owmh_start(OWMHS_POWER_HOLD);
 }
 #endif // defined (OW_PARASITE_POWER_SUPPORT)
 
+#ifdef OW_BROADCAST
+// Timer and delay interrupts of broadcast set. Operation succeeds while channels are left in set.
+static void owmh_broadcast_handler(void)
+{
+	owmh_callback_result_t result = OWMHCR_ERROR;
+	uint32_t pulse = 0;
+	uint32_t delay = 0;
+
+#ifdef OW_SLOT_RETRY
+	if (owmh_slot_retry())
+		return;
+#endif
+	switch (m_state)
+	{
+	case OWMHS_RESET:
+		owmh_broadcast_edges();
+		result = OWMHCR_RESET_OK;
+		break;
+
+	case OWMHS_SEQUENCE:
+		owmh_broadcast_edges();
+		if (--m_tx_count > 0)
+		{
+			if (m_byte_mask == 0x80)
+			{
+				m_byte_mask = 1;
+				++m_p_tx_buf;
+			}
+			else m_byte_mask <<= 1;
+			m_tx_bit = (*(m_p_tx_buf)&m_byte_mask);
+			pulse = (m_tx_bit) ? OW_READ_PULSE : OW_WRITE0_PULSE;
+			delay = OW_WRITE_TIMESLOT_DELAY;
+		}
+		else
+			result = OWMHCR_SEQUENCE_OK;
+		break;
+
+	case OWMHS_DELAY:
+#ifdef OW_PARASITE_POWER_SUPPORT
+	case OWMHS_POWER_HOLD:
+#endif
+#ifndef OW_LOW_POWER_DELAY
+		if (--m_delay_counter > 0)
+		{
+			pulse = OW_MILLISECOND_DELAY + 10;
+			delay = OW_MILLISECOND_DELAY;
+			break;
+		}
+#endif
+#ifdef OW_PARASITE_POWER_SUPPORT
+		if (m_state == OWMHS_POWER_HOLD)
+			owmh_broadcast_power(false);
+#endif
+		result = OWMHCR_WAIT_OK;
+		break;
+
+	default:
+		APP_ERROR_CHECK_BOOL(false);
+	}
+
+	// powered lines are checked after release only
+	if ((m_state < OWMHS_READ_FLAG) || (pulse == 0))
+		owmh_broadcast_lines();
+
+	if (m_broadcast == 0)
+	{
+		result = (m_state == OWMHS_RESET) ? OWMHCR_RESET_NO_RESPONCE : OWMHCR_ERROR;
+		pulse = 0;
+	}
+
+	if (pulse)
+	{
+		owmh_continue(pulse, delay);
+		return;
+	}
+	m_state = OWMHS_IDLE;
+	OWMH_IN_INT_IDLE();
+	m_callback(result);
+}
+#endif // OW_BROADCAST
+
 // timer interrupt handler (on compare2)
 static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_context)
 {
@@ -542,7 +2448,36 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 	uint32_t pulse = 0; 
 	uint32_t delay;
 
+	OWMH_ISR_COUNT();
+#ifdef OW_RESET_EARLY_EXIT
+	if (m_state == OWMHS_RESET)
+		owmh_in_int_set(m_in_pin, false);
+#endif
+#ifdef OW_FAULT_QUARANTINE
+	if (m_state == OWMHS_SKIP)
+	{
+		m_state = OWMHS_IDLE;
+		m_callback(OWMHCR_ERROR);
+		return;
+	}
+#endif
+#ifdef OW_BROADCAST
+	if (m_broadcast)
+	{
+		owmh_broadcast_handler();
+		return;
+	}
+#endif
+#ifdef OW_SLOT_EARLY_END
+	if (owmh_slot_extend())
+		return;
+#endif
+#ifdef OW_SLOT_RETRY
+	if (owmh_slot_retry())
+		return;
+#endif
 	capture_value = nrf_drv_timer_capture_get(&ow_timer, NRF_TIMER_CC_CHANNEL0);
+	OWMH_TRACE_SLOT(capture_value);
 	switch (m_state)
 	{
 //----------------------------------------------------------------------------------------------------------------	
@@ -550,35 +2485,102 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 		if ((capture_value < OW_RESET_PULSE) || (capture_value > (OW_RESET_DELAY - 30)))
 			result = OWMHCR_ERROR;
 		else if(capture_value > OW_PRESENCE_BOUND)
+		{
+			OWMH_CALIB_PRESENCE(capture_value);
+			OWMH_HIST_PRESENCE(capture_value);
 			result = OWMHCR_RESET_OK;
+		}
 		else
+		{
+			OWMH_CALIB_RISE(OW_RESET_PULSE, capture_value);
 			result = OWMHCR_RESET_NO_RESPONCE;
+		}
 		break;
 //----------------------------------------------------------------------------------------------------------------	
 	case OWMHS_WRITE1:
 		if ((capture_value < OW_WRITE1_PULSE) || (capture_value > (OW_WRITE_TIMESLOT_DELAY - 30)))
 			result = OWMHCR_ERROR;
 		else
+		{
+			OWMH_CALIB_RISE(OW_WRITE1_PULSE, capture_value);
+			OWMH_HIST_WRITE(1, capture_value);
 			result = OWMHCR_WRITE_OK;
+		}
 		break;
 //----------------------------------------------------------------------------------------------------------------	
 	case OWMHS_WRITE0:
 		if ((capture_value < OW_WRITE0_PULSE) || (capture_value > (OW_WRITE0_PULSE + 15)))
 			result = OWMHCR_ERROR;
 		else
+		{
+			OWMH_CALIB_RISE(OW_WRITE0_PULSE, capture_value);
+			OWMH_HIST_WRITE(0, capture_value);
 			result = OWMHCR_WRITE_OK;
+		}
 		break;
 //----------------------------------------------------------------------------------------------------------------	
 	case OWMHS_READ:
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_ID:
+	case OWMHS_TRIPLET_CMP:
+#endif
 		if ((capture_value < OW_WRITE1_PULSE) || (capture_value > (OW_READ_TIMESLOT_DELAY - 30)))
 			result = OWMHCR_ERROR;
 		else if(capture_value > OW_READ0_BOUND)
+		{
+			OWMH_CALIB_READ0(capture_value);
+			OWMH_HIST_READ0(capture_value);
 			result = OWMHCR_READ_0;
+		}
 		else if(capture_value < OW_READ1_BOUND)
+		{
+			OWMH_CALIB_RISE(OW_READ_PULSE, capture_value);
+			OWMH_HIST_READ1(capture_value);
 			result = OWMHCR_READ_1;
+		}
+		else
+			result = OWMHCR_ERROR;
+#ifdef OW_ROM_SEARCH_SUPPORT
+		if ((m_state == OWMHS_READ) || (result == OWMHCR_ERROR))
+			break;
+		if (m_state == OWMHS_TRIPLET_ID)
+		{
+			// read complement bit
+			if (result == OWMHCR_READ_1)
+				m_triplet |= OWMH_TRIPLET_ID;
+			state = OWMHS_TRIPLET_CMP;
+			pulse = OW_READ_PULSE;
+			delay = OW_READ_TIMESLOT_DELAY;
+			break;
+		}
+		if (result == OWMHCR_READ_1)
+			m_triplet |= OWMH_TRIPLET_CMP;
+		// write direction: direct bit, if no discrepancy. Hint (already in DIR bit) at discrepancy
+		if ((m_triplet & OWMH_TRIPLET_ID) || (!(m_triplet & OWMH_TRIPLET_CMP) && (m_triplet & OWMH_TRIPLET_DIR)))
+			m_triplet |= OWMH_TRIPLET_DIR;
 		else
+			m_triplet &= (uint8_t)(~OWMH_TRIPLET_DIR);
+		m_tx_bit = ((m_triplet & OWMH_TRIPLET_DIR) != 0);
+		state = OWMHS_TRIPLET_DIR;
+		pulse = (m_tx_bit) ? OW_READ_PULSE : OW_WRITE0_PULSE;
+		delay = OW_WRITE_TIMESLOT_DELAY;
+#endif
+		break;
+//----------------------------------------------------------------------------------------------------------------	
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_DIR:
+		if ((m_tx_bit)
+			? ((capture_value < OW_WRITE1_PULSE) || (capture_value > (OW_WRITE_TIMESLOT_DELAY - 30)))
+			: ((capture_value < OW_WRITE0_PULSE) || (capture_value > (OW_WRITE0_PULSE + 15))))
 			result = OWMHCR_ERROR;
+		else
+		{
+			OWMH_CALIB_RISE((m_tx_bit) ? OW_WRITE1_PULSE : OW_WRITE0_PULSE, capture_value);
+			OWMH_HIST_WRITE(m_tx_bit, capture_value);
+			result = (owmh_callback_result_t)(OWMHCR_TRIPLET | m_triplet);
+		}
 		break;
+#endif
 //----------------------------------------------------------------------------------------------------------------	
 	case OWMHS_DELAY:
 		if (--m_delay_counter > 0)
@@ -611,14 +2613,38 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 			result = OWMHCR_ERROR;
 		else if (capture_value < OW_READ1_BOUND)
 		{
+			OWMH_CALIB_RISE(OW_READ_PULSE, capture_value);
+			OWMH_HIST_READ1(capture_value);
 			result = OWMHCR_FLAG_OK;
 		}
+#ifdef OW_PREDICTIVE_FLAG_POLL
+		else if ((delay = ow_flag_poll_next(&m_flag_poll, OW_READ_TIMESLOT_DELAY / DELAY_MKS(1))) > 0)
+		{
+			OWMH_CALIB_READ0(capture_value);
+			OWMH_HIST_READ0(capture_value);
+			state = OWMHS_FLAG_PAUSE;
+#ifdef OW_LOW_POWER_DELAY
+			if (delay >= 1000)
+			{
+				// long pause without HFCLK
+				m_state = state;
+				APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, OW_APP_TIMER_TICKS_US(delay), NULL));
+				return;
+			}
+#endif
+			delay = DELAY_MKS(delay);
+			pulse = delay + 10;
+		}
+#else
 		else if (m_delay_counter > 0)
 		{
+			OWMH_CALIB_READ0(capture_value);
+			OWMH_HIST_READ0(capture_value);
 			state = OWMHS_FLAG_PAUSE;
 			pulse = OW_FLAG_PAUSE_DELAY + 10;
 			delay = OW_FLAG_PAUSE_DELAY;
 		}
+#endif
 		else
 		{
 			result = OWMHCR_TIME_OUT;
@@ -626,7 +2652,9 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 		break;
 //----------------------------------------------------------------------------------------------------------------	
 	case OWMHS_FLAG_PAUSE :
+#ifndef OW_PREDICTIVE_FLAG_POLL
 		--m_delay_counter;
+#endif
 		state = OWMHS_READ_FLAG;
 		pulse = OW_WRITE1_PULSE;
 		delay = OW_READ_TIMESLOT_DELAY;
@@ -642,6 +2670,8 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 				result = OWMHCR_ERROR;
 				break;
 			}
+			OWMH_CALIB_RISE((m_tx_bit) ? OW_WRITE1_PULSE : OW_WRITE0_PULSE, capture_value);
+			OWMH_HIST_WRITE(m_tx_bit, capture_value);
 
 			if (--m_tx_count > 0) // There are more bits to transmit
 				{
@@ -653,6 +2683,9 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 					}
 					else m_byte_mask <<= 1;
 					// form next 1-WIRE writing timeslot
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+					OWMH_PULLUP_SLOT();
+#endif
 					m_tx_bit = (*(m_p_tx_buf)&m_byte_mask);
 					pulse = (m_tx_bit) ? OW_READ_PULSE : OW_WRITE0_PULSE;
 					delay = OW_WRITE_TIMESLOT_DELAY;
@@ -681,12 +2714,28 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 				}
 				
 				if (capture_value < OW_READ1_BOUND)
+				{
+					OWMH_CALIB_RISE(OW_READ_PULSE, capture_value);
+					OWMH_HIST_READ1(capture_value);
 					*(m_p_rx_buf) |= m_byte_mask;
+				}
 				else 
+				{
+					OWMH_CALIB_READ0(capture_value);
+					OWMH_HIST_READ0(capture_value);
 					*(m_p_rx_buf) &= (~m_byte_mask);
+				}
 				
 				if (m_byte_mask == 0x80)
 				{
+#ifdef OW_RX_CRC8
+					// byte completed. Rest of sequence is not transferred, if its CRC8 check fails
+					if (!owmh_rx_crc_byte(*(m_p_rx_buf)))
+					{
+						result = OWMHCR_CRC_ERROR;
+						break;
+					}
+#endif
 					m_byte_mask = 1;
 					++m_p_rx_buf;
 				}
@@ -702,6 +2751,12 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 			}
 		break;
 //----------------------------------------------------------------------------------------------------------------	
+#ifdef OW_SLOT_ENGINE
+	case OWMHS_SEQUENCE_TAIL :
+		result = OWMHCR_SEQUENCE_OK;
+		break;
+//----------------------------------------------------------------------------------------------------------------	
+#endif
 		default: // OWMHS_IDLE, OWMHS_NOT_INITIALIZED
 			APP_ERROR_CHECK_BOOL(false);
 //----------------------------------------------------------------------------------------------------------------	
@@ -717,7 +2772,58 @@ static void ow_timer_event_handler(nrf_timer_event_t event_type, void * p_contex
 	}
 	else
 	{
+		if (result == OWMHCR_ERROR)
+		{
+			OWMH_CALIB_ERROR();
+			OWMH_FAULT_SLOT();
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+			owmh_pullup_release();
+#endif
+		}
 		m_state = OWMHS_IDLE;
+		OWMH_IN_INT_IDLE();
 		m_callback(result);
 	}
 }
+
+#ifdef OW_LOW_POWER_DELAY
+// app_timer handler. Completion of delay, hold power and long flag polling pause.
+static void ow_delay_timer_handler(void * p_context)
+{
+	UNUSED_PARAMETER(p_context);	
+	owmh_callback_result_t result = OWMHCR_WAIT_OK;
+
+	OWMH_ISR_COUNT();
+#ifdef OW_BROADCAST
+	if (m_broadcast)
+	{
+		owmh_broadcast_handler();
+		return;
+	}
+#endif
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	if (m_state == OWMHS_FLAG_PAUSE)
+	{
+		// next flag reading
+		m_state = OWMHS_READ_FLAG;
+		owmh_continue(OW_WRITE1_PULSE, OW_READ_TIMESLOT_DELAY);
+		return;
+	}
+#endif
+#ifdef OW_PARASITE_POWER_SUPPORT
+	if (m_state == OWMHS_POWER_HOLD)
+		ow_power_off();
+#endif
+	if (!nrf_gpio_pin_read(m_in_pin))
+	{
+		OWMH_FAULT(OWMH_FAULT_NO_RELEASE);
+		result = OWMHCR_ERROR;
+	}
+
+	m_state = OWMHS_IDLE;
+	OWMH_IN_INT_IDLE();
+	m_callback(result);
+}
+#endif
+
+#endif // OW_HAL_TIMER
@@ -0,0 +1,515 @@
+#include "ow_master_hal.h"
+
+#ifdef OW_HAL_SIM
+
+#include "app_error.h"
+
+#include "ow_sim.h"
+#ifdef OW_PREDICTIVE_FLAG_POLL
+#include "ow_flag_poll.h"
+#endif
+#ifdef OW_BUS_FAULTS
+#include "ow_bus_fault.h"
+#endif
+
+// Simulated HAL backend. Operation is evaluated on bus model at once, callback is invoked
+// by simulator event after bus time of operation. Timing follows TIMER backend profiles.
+
+#define OW_FLAG_PAUSE_US		1000
+
+/**
+ * Timing of bus speed or profile, microseconds
+ */
+typedef struct
+{
+	uint16_t write_slot;
+	uint16_t read_slot;
+	uint16_t reset_slot;
+	uint16_t presence_end;   // end of presence pulse of simulated devices
+} owmh_sim_timing_t;
+
+#ifdef OW_SLOT_EARLY_END
+// slot is finished at recovery time after latest release edge (write 0 pulse, 0 bit of
+// simulated devices), but not before minimal timeslot and not after full slot
+#define OW_SIM_SLOT(slot, edge, min) \
+	((((edge) + OW_SLOT_EARLY_END) > (slot)) ? (slot) : \
+	((((edge) + OW_SLOT_EARLY_END) > (min)) ? ((edge) + OW_SLOT_EARLY_END) : (min)))
+#else
+#define OW_SIM_SLOT(slot, edge, min) (slot)
+#endif
+
+static const owmh_sim_timing_t m_profile_timing[OWMH_PROFILE_COUNT] =
+{
+	{	// OWMH_PROFILE_STANDARD
+		.write_slot = OW_SIM_SLOT(70, 60+2, 61), .read_slot = OW_SIM_SLOT(100, 30, 61),
+		.reset_slot = 600+300, .presence_end = 600+150
+	},
+	{	// OWMH_PROFILE_FAST
+		.write_slot = OW_SIM_SLOT(63, 60+1, 61), .read_slot = OW_SIM_SLOT(65, 30, 61),
+		.reset_slot = 500+310, .presence_end = 500+150
+	},
+	{	// OWMH_PROFILE_LONG_LINE
+		.write_slot = OW_SIM_SLOT(85, 60+5, 61), .read_slot = OW_SIM_SLOT(110, 30, 61),
+		.reset_slot = 600+400, .presence_end = 600+150
+	},
+};
+#ifdef OW_OVERDRIVE_SUPPORT
+static const owmh_sim_timing_t m_overdrive_timing =
+{
+	.write_slot = OW_SIM_SLOT(11, 8+1, 7), .read_slot = OW_SIM_SLOT(15, 3, 7),
+	.reset_slot = 74+50, .presence_end = 74+20
+};
+#endif
+
+static owmh_callback_t          m_callback;
+static bool                     m_initialized;
+static bool                     m_busy;
+static owmh_callback_result_t   m_result;
+static uint8_t                  m_channel;
+static bool                     m_overdrive;
+static owmh_profile_t           m_profile[OW_SIM_CHANNEL_COUNT];
+static const owmh_sim_timing_t* m_p_timing = &m_profile_timing[OWMH_PROFILE_STANDARD];
+
+#ifdef OW_RX_CRC8
+static uint8_t  m_rx_crc8;
+static uint8_t  m_rx_crc_check;    // armed for next sequence
+static uint8_t  m_rx_crc_left;     // bytes left to end of checked block
+static bool     m_rx_crc_continue; // next sequence continues CRC8 and checked block
+#endif
+
+#ifdef OW_HAL_STAGING
+// Staged sequence. It is started from completion event before callback of master.
+typedef struct
+{
+	uint8_t*  p_txdata;
+	uint8_t*  p_rxdata;
+	uint16_t  tx_count;
+	uint16_t  rx_count;
+	uint8_t   crc_check;       // CRC8 checking armed for staged sequence
+	bool      armed;
+} owmh_stage_t;
+
+static owmh_stage_t    m_stage;
+static owmh_callback_t m_stage_callback;   // callback of master
+
+static void owmh_stage_callback(owmh_callback_result_t result)
+{
+	if (m_stage.armed)
+	{
+		m_stage.armed = false;
+		if ((result == OWMHCR_RESET_OK) || (result == OWMHCR_SEQUENCE_OK))
+		{
+#ifdef OW_RX_CRC8
+			owmh_rx_crc_check(m_stage.crc_check);
+#endif
+			owmh_sequence(m_stage.p_txdata, m_stage.p_rxdata, m_stage.tx_count, m_stage.rx_count);
+		}
+	}
+	m_stage_callback(result);
+}
+
+void owmh_sequence_stage(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL((!m_stage.armed) && ((tx_count) || (rx_count)));
+	m_stage.p_txdata  = p_txdata;
+	m_stage.p_rxdata  = p_rxdata;
+	m_stage.tx_count  = tx_count;
+	m_stage.rx_count  = rx_count;
+	m_stage.crc_check = 0;
+	m_stage.armed     = true;
+}
+#endif
+
+#ifdef OW_HAL_ISR_COUNTER
+static uint32_t m_isr_count;
+static uint64_t m_active_us;
+
+uint32_t owmh_isr_count(void)
+{
+	return m_isr_count;
+}
+
+uint32_t owmh_active_time_us(void)
+{
+	return (uint32_t)m_active_us;
+}
+#endif
+
+void owm_hal_initialize(owmh_callback_t callback)
+{
+	APP_ERROR_CHECK_BOOL(!m_initialized);
+#ifdef OW_HAL_STAGING
+	m_stage_callback = callback;
+	m_callback = owmh_stage_callback;
+#else
+	m_callback = callback;
+#endif
+	m_channel = 0;
+	m_overdrive = false;
+	m_busy = false;
+	m_initialized = true;
+}
+
+uint32_t owm_hal_uninitialize(void)
+{
+	if (m_busy)
+		return 1;
+	m_initialized = false;
+	return 0;
+}
+
+#ifdef OW_MULTI_CHANNEL
+void ow_set_channel(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_CHANNEL_COUNT);
+	APP_ERROR_CHECK_BOOL(!m_busy);
+	m_channel = channel;
+}
+#endif
+
+#ifdef OW_BUS_FAULTS
+// failed operation: shorted line, otherwise corrupted slot
+static ow_bus_fault_t m_fault[OW_SIM_CHANNEL_COUNT];
+
+void owmh_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_SIM_CHANNEL_COUNT);
+	ow_bus_fault_stats(&m_fault[channel], p_stats, clear);
+}
+#endif
+
+// Completion event of operation
+static void owmh_sim_complete(void* p_context)
+{
+	(void)p_context;
+#ifdef OW_HAL_ISR_COUNTER
+	++m_isr_count;
+#endif
+	m_busy = false;
+	m_callback(m_result);
+}
+
+static void owmh_sim_finish(ow_sim_op_t op, owmh_callback_result_t result, uint32_t duration_us, uint32_t slots)
+{
+	m_result = result;
+#ifdef OW_BUS_FAULTS
+	if (result == OWMHCR_ERROR)
+		ow_bus_fault_put(&m_fault[m_channel], (ow_sim_bus_shorted(m_channel)) ? OWMH_FAULT_SHORT : OWMH_FAULT_TIMING);
+#endif
+	ow_sim_account(op, duration_us, slots);
+#ifdef OW_HAL_ISR_COUNTER
+	m_active_us += duration_us;
+#endif
+	ow_sim_schedule(duration_us, owmh_sim_complete, NULL);
+}
+
+#ifdef OW_FAULT_QUARANTINE
+// Skip is completed by event at current time, line is not touched
+bool owmh_quarantine_skip(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_SIM_CHANNEL_COUNT) && (m_initialized) && (!m_busy));
+	if (!ow_bus_fault_skip(&m_fault[channel]))
+		return false;
+	m_busy = true;
+	m_result = OWMHCR_ERROR;
+	ow_sim_schedule(0, owmh_sim_complete, NULL);
+	return true;
+}
+#endif
+
+// Operation start. Operations on shorted line fail after first slot
+static bool owmh_sim_start(ow_sim_op_t op, uint32_t slot_us)
+{
+	APP_ERROR_CHECK_BOOL((m_initialized) && (!m_busy));
+	m_busy = true;
+	if (!ow_sim_bus_shorted(m_channel))
+	{
+#ifdef OW_BUS_FAULTS
+		ow_bus_fault_released(&m_fault[m_channel]);
+#endif
+		return true;
+	}
+	owmh_sim_finish(op, OWMHCR_ERROR, slot_us, 0);
+	return false;
+}
+
+static uint8_t owmh_sim_slot(uint8_t bit, uint64_t time_us)
+{
+	return ow_sim_bus_slot(m_channel, bit, time_us, m_overdrive);
+}
+
+void owmh_reset(void)
+{
+	bool     presence;
+	uint32_t duration_us;
+
+	// profile of channel is applied from reset
+#ifdef OW_OVERDRIVE_SUPPORT
+	m_p_timing = (m_overdrive) ? &m_overdrive_timing : &m_profile_timing[m_profile[m_channel]];
+#else
+	m_p_timing = &m_profile_timing[m_profile[m_channel]];
+#endif
+	if (!owmh_sim_start(OW_SIM_OP_RESET, m_p_timing->reset_slot))
+		return;
+	presence = ow_sim_bus_reset(m_channel, ow_sim_time_us(), m_overdrive);
+	duration_us = m_p_timing->reset_slot;
+#ifdef OW_RESET_EARLY_EXIT
+	// slot is finished after presence pulse and recovery time
+	if ((presence) && (m_p_timing->presence_end + OW_RESET_EARLY_EXIT < duration_us))
+		duration_us = m_p_timing->presence_end + OW_RESET_EARLY_EXIT;
+#endif
+	owmh_sim_finish(OW_SIM_OP_RESET, (presence) ? OWMHCR_RESET_OK : OWMHCR_RESET_NO_RESPONCE,
+		duration_us, 0);
+}
+
+void owmh_write(uint8_t bit)
+{
+	if (!owmh_sim_start(OW_SIM_OP_WRITE, m_p_timing->write_slot))
+		return;
+	// device driving line in write 1 slot corrupts it
+	bit = (bit) ? 1 : 0;
+	owmh_sim_finish(OW_SIM_OP_WRITE, (owmh_sim_slot(bit, ow_sim_time_us()) == bit) ? OWMHCR_WRITE_OK : OWMHCR_ERROR,
+		m_p_timing->write_slot, 1);
+}
+
+void owmh_read(void)
+{
+	if (!owmh_sim_start(OW_SIM_OP_READ, m_p_timing->read_slot))
+		return;
+	owmh_sim_finish(OW_SIM_OP_READ, (owmh_sim_slot(1, ow_sim_time_us())) ? OWMHCR_READ_1 : OWMHCR_READ_0,
+		m_p_timing->read_slot, 1);
+}
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+void owmh_triplet(uint8_t direction)
+{
+	uint64_t time_us = ow_sim_time_us();
+	uint8_t  triplet = 0;
+
+	if (!owmh_sim_start(OW_SIM_OP_TRIPLET, m_p_timing->read_slot))
+		return;
+	if (owmh_sim_slot(1, time_us))
+		triplet |= OWMH_TRIPLET_ID;
+	if (owmh_sim_slot(1, time_us + m_p_timing->read_slot))
+		triplet |= OWMH_TRIPLET_CMP;
+	// direct bit, if no discrepancy. Hint at discrepancy
+	if ((triplet & OWMH_TRIPLET_ID) || ((!(triplet & OWMH_TRIPLET_CMP)) && (direction)))
+		triplet |= OWMH_TRIPLET_DIR;
+	owmh_sim_slot((triplet & OWMH_TRIPLET_DIR) ? 1 : 0, time_us + 2 * m_p_timing->read_slot);
+	owmh_sim_finish(OW_SIM_OP_TRIPLET, (owmh_callback_result_t)(OWMHCR_TRIPLET | triplet),
+		2 * m_p_timing->read_slot + m_p_timing->write_slot, 3);
+}
+#endif
+
+void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	owmh_callback_result_t result = OWMHCR_SEQUENCE_OK;
+	uint32_t duration_us = 0;
+	uint32_t slot;
+
+	if ((!tx_count)&&(!rx_count)) return;
+#ifdef OW_RX_CRC8
+	if (!m_rx_crc_continue)
+	{
+		m_rx_crc8 = 0;
+		m_rx_crc_left = m_rx_crc_check;
+	}
+	m_rx_crc_continue = false;
+	m_rx_crc_check = 0;
+#endif
+	if (!owmh_sim_start(OW_SIM_OP_SEQUENCE, m_p_timing->write_slot))
+		return;
+	for (slot = 0; slot < (uint32_t)tx_count + rx_count; ++slot)
+	{
+		uint64_t time_us = ow_sim_time_us() + duration_us;
+
+		if (slot < tx_count)
+		{
+			uint8_t bit = (p_txdata[slot >> 3] >> (slot & 0x07)) & 0x01;
+
+			duration_us += m_p_timing->write_slot;
+			if (owmh_sim_slot(bit, time_us) != bit)
+			{
+				result = OWMHCR_ERROR;
+				break;
+			}
+		}
+		else
+		{
+			uint32_t rx_slot = slot - tx_count;
+			uint8_t  mask = (uint8_t)(1 << (rx_slot & 0x07));
+
+			duration_us += m_p_timing->read_slot;
+			if (owmh_sim_slot(1, time_us))
+				p_rxdata[rx_slot >> 3] |= mask;
+			else
+				p_rxdata[rx_slot >> 3] &= (uint8_t)(~mask);
+#ifdef OW_RX_CRC8
+			if (mask != 0x80)
+				continue;
+			docrc8(&m_rx_crc8, p_rxdata[rx_slot >> 3]);
+			if ((m_rx_crc_left > 0) && (--m_rx_crc_left == 0) && (m_rx_crc8 != 0))
+			{
+				// rest of sequence is not transferred
+				result = OWMHCR_CRC_ERROR;
+				++slot;
+				break;
+			}
+#endif
+		}
+	}
+	owmh_sim_finish(OW_SIM_OP_SEQUENCE, result, duration_us, (result == OWMHCR_ERROR) ? (slot + 1) : slot);
+}
+
+#ifdef OW_RX_CRC8
+void owmh_rx_crc_check(uint8_t check_count)
+{
+#ifdef OW_HAL_STAGING
+	if (m_stage.armed)
+	{
+		// current operation can be in progress
+		m_stage.crc_check = check_count;
+		return;
+	}
+#endif
+	APP_ERROR_CHECK_BOOL(!m_busy);
+	m_rx_crc_check = check_count;
+}
+
+void owmh_rx_crc_continue(void)
+{
+	APP_ERROR_CHECK_BOOL(!m_busy);
+	m_rx_crc_continue = true;
+}
+
+uint8_t owmh_rx_crc8(void)
+{
+	return m_rx_crc8;
+}
+#endif
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+// strong pull-up is not modeled, hold power follows the sequence
+void owmh_arm_power(void)
+{
+	APP_ERROR_CHECK_BOOL(!m_busy);
+}
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+void owmh_set_speed(bool overdrive)
+{
+	APP_ERROR_CHECK_BOOL(!m_busy);
+	m_overdrive = overdrive;
+	m_p_timing = (overdrive) ? &m_overdrive_timing : &m_profile_timing[m_profile[m_channel]];
+}
+#endif
+
+void owmh_set_profile(uint8_t channel, owmh_profile_t profile)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_SIM_CHANNEL_COUNT) && (profile < OWMH_PROFILE_COUNT));
+	m_profile[channel] = profile;
+}
+
+#ifdef OW_BUS_CALIBRATION
+// bus model has no edges to calibrate by
+void owmh_calibrate(uint8_t channel)
+{
+	(void)channel;
+}
+
+bool owmh_calibrated(uint8_t channel)
+{
+	(void)channel;
+	return false;
+}
+#endif
+
+void owmh_wait_flag(uint16_t max_wait_ms)
+{
+	owmh_callback_result_t result = OWMHCR_TIME_OUT;
+	uint32_t duration_us = 0;
+	uint32_t slots = 0;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	ow_flag_poll_t poll;
+	uint32_t       pause;
+
+	ow_flag_poll_init(&poll, max_wait_ms);
+#endif
+
+	if (!owmh_sim_start(OW_SIM_OP_WAIT_FLAG, m_p_timing->read_slot))
+		return;
+	// flag is read at start and after every pause until time-out
+	for (;;)
+	{
+		++slots;
+		if (owmh_sim_slot(1, ow_sim_time_us() + duration_us))
+		{
+			duration_us += m_p_timing->read_slot;
+			result = OWMHCR_FLAG_OK;
+			break;
+		}
+#ifdef OW_PREDICTIVE_FLAG_POLL
+		pause = ow_flag_poll_next(&poll, m_p_timing->read_slot);
+		if (pause == 0)
+		{
+			duration_us += m_p_timing->read_slot;
+			break;
+		}
+		duration_us += m_p_timing->read_slot + pause;
+#else
+		if (max_wait_ms == 0)
+		{
+			duration_us += m_p_timing->read_slot;
+			break;
+		}
+		--max_wait_ms;
+		duration_us += OW_FLAG_PAUSE_US;
+#endif
+	}
+	owmh_sim_finish(OW_SIM_OP_WAIT_FLAG, result, duration_us, slots);
+}
+
+void owmh_delay(uint16_t delay_ms)
+{
+	if (!owmh_sim_start(OW_SIM_OP_DELAY, (uint32_t)delay_ms * 1000))
+		return;
+	owmh_sim_finish(OW_SIM_OP_DELAY, OWMHCR_WAIT_OK, (uint32_t)delay_ms * 1000, 0);
+}
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+void owmh_hold_power(uint16_t delay_ms)
+{
+	// line is driven high, parasite powered devices complete their operations
+	APP_ERROR_CHECK_BOOL((m_initialized) && (!m_busy));
+	m_busy = true;
+	owmh_sim_finish(OW_SIM_OP_HOLD_POWER, OWMHCR_WAIT_OK, (uint32_t)delay_ms * 1000, 0);
+}
+#endif
+
+#ifdef OW_HOT_PLUG
+static owmh_hot_plug_handler_t m_hot_plug_handler[OW_SIM_CHANNEL_COUNT];
+static uint32_t                m_hot_plug_armed;     // armed channels
+
+// presence pulse of attached device
+static void owmh_sim_attached(uint8_t channel)
+{
+	// presence on channel in transfer is part of transfer
+	if ((m_busy) && (channel == m_channel))
+		return;
+	if (!(m_hot_plug_armed & (1UL << channel)))
+		return;
+	m_hot_plug_armed &= ~(1UL << channel);
+	m_hot_plug_handler[channel](channel);
+}
+
+void owmh_hot_plug_arm(uint8_t channel, owmh_hot_plug_handler_t handler)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_SIM_CHANNEL_COUNT);
+	m_hot_plug_handler[channel] = handler;
+	m_hot_plug_armed |= (1UL << channel);
+	ow_sim_bus_watch(owmh_sim_attached);
+}
+#endif
+
+#endif // OW_HAL_SIM
@@ -0,0 +1,908 @@
+#include "ow_master_hal.h"
+
+#ifdef OW_HAL_UARTE
+
+// UARTE HAL backend. Requires exclusive UARTE instance OW_UARTE_INSTANCE: its IRQ is shared
+// with UART of same instance through PRS box, so UART driver of instance (UART<n>_ENABLED,
+// NRFX_UART<n>_ENABLED, NRFX_UARTE<n>_ENABLED) must be disabled in sdk_config.h.
+
+#include <nrfx.h>
+#include <hal/nrf_gpio.h>
+#include <hal/nrf_uarte.h>
+#include "prs/nrfx_prs.h"
+#include "app_timer.h"
+
+#include "app_error.h"
+
+#include "ow_uart_codec.h"
+#ifdef OW_PREDICTIVE_FLAG_POLL
+#include "ow_flag_poll.h"
+#endif
+#ifdef OW_RX_CRC8
+#include "ow_packet.h"
+#endif
+#ifdef OW_BUS_FAULTS
+#include "app_util_platform.h"
+#include "ow_bus_fault.h"
+#endif
+
+#if (NRFX_CHECK(NRFX_CONCAT_3(UART, OW_UARTE_INSTANCE, _ENABLED)) || \
+	NRFX_CHECK(NRFX_CONCAT_3(NRFX_UART, OW_UARTE_INSTANCE, _ENABLED)) || \
+	NRFX_CHECK(NRFX_CONCAT_3(NRFX_UARTE, OW_UARTE_INSTANCE, _ENABLED)))
+#error "OW_HAL_UARTE: UART driver of OW_UARTE_INSTANCE must be disabled in sdk_config.h"
+#endif
+
+// OW master HAL states
+typedef enum
+{
+	OWMHS_IDLE,
+
+	OWMHS_RESET,
+	OWMHS_READ,
+	OWMHS_WRITE,
+#ifdef OW_ROM_SEARCH_SUPPORT
+	OWMHS_TRIPLET_READ,
+	OWMHS_TRIPLET_WRITE,
+#endif
+
+	OWMHS_SEQUENCE,
+
+	OWMHS_READ_FLAG,
+	OWMHS_FLAG_PAUSE,
+	OWMHS_DELAY,
+#ifdef OW_PARASITE_POWER_SUPPORT
+	OWMHS_POWER_HOLD,
+#endif
+#ifdef OW_FAULT_QUARANTINE
+	OWMHS_SKIP,                    // packet of quarantined channel, no bus activity
+#endif
+
+	OWMHS_NOT_INITIALIZED
+} owmh_state_t;
+
+// Maximal EasyDMA transfer length (MAXCNT register is 8 bit wide in nRF52832).
+// Longer sequences are transferred in several parts.
+#define OW_UARTE_DMA_MAX_COUNT	255
+
+#define OW_FLAG_PAUSE_MS		1
+
+#ifdef OW_PREDICTIVE_FLAG_POLL
+// read slot duration, us
+#define OW_FLAG_SLOT_US			100
+#define OW_APP_TIMER_TICKS_US(us) \
+	((uint32_t)ROUNDED_DIV((us) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1)))
+static ow_flag_poll_t m_flag_poll;
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+// Overdrive reset baudrate, ~66.6 kBd (not in list of standard values).
+// OW_UART_RESET byte holds line low for 75 us.
+#define OW_UARTE_BAUDRATE_RESET_OVERDRIVE	((nrf_uarte_baudrate_t)0x01111000)
+#endif
+
+static NRF_UARTE_Type * const ow_uarte = NRFX_CONCAT_2(NRF_UARTE, OW_UARTE_INSTANCE);
+
+APP_TIMER_DEF(m_ow_delay_timer);
+
+static uint32_t         m_out_pin;
+static uint32_t         m_in_pin;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+static uint32_t         m_pwr_pin;
+#endif
+
+static owmh_callback_t  m_callback;
+
+#ifdef OW_BUS_FAULTS
+static uint8_t          m_channel;       // current channel
+static ow_bus_fault_t   m_fault[OW_FAULT_CHANNELS];
+#endif
+
+#ifdef OW_MULTI_CHANNEL
+typedef struct
+{
+	uint32_t tx_pin;
+	uint32_t rx_pin;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	uint32_t pwr_pin;
+#endif
+} ow_channal_rec_t;
+
+static const ow_channal_rec_t ow_pins[OW_CHANNEL_COUNT] = OW_PINS_ARRAY;
+#endif // (defined (OW_MULTI_CHANNEL))
+
+static volatile owmh_state_t m_state = OWMHS_NOT_INITIALIZED;
+static uint8_t*   m_p_tx_buf;
+static uint8_t*   m_p_rx_buf;
+static uint16_t   m_tx_count;
+static uint16_t   m_slot_count;    // total number of timeslots in sequence
+static uint16_t   m_slot_index;    // first timeslot of transfer under processing
+static uint16_t   m_dma_count;     // number of timeslots in transfer under processing
+static uint16_t   m_delay_counter;
+#ifdef OW_ROM_SEARCH_SUPPORT
+static uint8_t    m_triplet;       // OWMH_TRIPLET_* bits of triplet under processing
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+static bool       m_pullup_armed;  // pull-up armed for next sequence
+static bool       m_pullup_hw;     // out pin drives high during and after sequence
+#endif
+
+// Line coding of current bus speed
+static nrf_uarte_baudrate_t m_reset_baudrate = NRF_UARTE_BAUDRATE_9600;
+static nrf_uarte_baudrate_t m_data_baudrate  = NRF_UARTE_BAUDRATE_115200;
+static uint8_t              m_bit_0          = OW_UART_BIT_0;
+#ifdef OW_HAL_ISR_COUNTER
+static uint16_t             m_reset_byte_us  = 1042;  // 10 bits of UART frame
+static uint16_t             m_data_byte_us   = 87;
+#endif
+
+// EasyDMA buffers. Must be placed in RAM.
+static uint8_t    m_uart_tx_buf[OW_UARTE_DMA_MAX_COUNT];
+static uint8_t    m_uart_rx_buf[OW_UARTE_DMA_MAX_COUNT];
+
+#ifdef OW_HAL_ISR_COUNTER
+static uint32_t   m_isr_count;
+static uint32_t   m_active_us;     // duration of UARTE transfers
+#define OWMH_ISR_COUNT()		(++m_isr_count)
+#define OWMH_ACTIVE_US(time_us)	(m_active_us += (time_us))
+
+uint32_t owmh_isr_count(void)
+{
+	return m_isr_count;
+}
+
+uint32_t owmh_active_time_us(void)
+{
+	return m_active_us;
+}
+#else
+#define OWMH_ISR_COUNT()
+#define OWMH_ACTIVE_US(time_us)
+#endif
+
+#ifdef OW_HAL_STAGING
+// Staged sequence. It is started from UARTE completion interrupt before callback of master.
+typedef struct
+{
+	uint8_t*  p_txdata;
+	uint8_t*  p_rxdata;
+	uint16_t  tx_count;
+	uint16_t  rx_count;
+	uint8_t   crc_check;       // CRC8 checking armed for staged sequence
+	bool      armed;
+} owmh_stage_t;
+
+static owmh_stage_t     m_stage;
+static owmh_callback_t  m_stage_callback;  // callback of master
+
+static void owmh_stage_callback(owmh_callback_result_t result)
+{
+	if (m_stage.armed)
+	{
+		m_stage.armed = false;
+		if ((result == OWMHCR_RESET_OK) || (result == OWMHCR_SEQUENCE_OK))
+		{
+#ifdef OW_RX_CRC8
+			owmh_rx_crc_check(m_stage.crc_check);
+#endif
+			owmh_sequence(m_stage.p_txdata, m_stage.p_rxdata, m_stage.tx_count, m_stage.rx_count);
+		}
+	}
+	m_stage_callback(result);
+}
+
+void owmh_sequence_stage(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL((!m_stage.armed) && ((tx_count) || (rx_count)));
+	m_stage.p_txdata  = p_txdata;
+	m_stage.p_rxdata  = p_rxdata;
+	m_stage.tx_count  = tx_count;
+	m_stage.rx_count  = rx_count;
+	m_stage.crc_check = 0;
+	m_stage.armed     = true;
+}
+#endif
+
+#ifdef OW_RX_CRC8
+// CRC8 is updated by bytes completed in every transferred part of sequence. Part is ended
+// on last byte of checked block, so rest of sequence is not transferred, if check fails.
+static uint8_t    m_rx_crc8;       // CRC8 of received bytes of current sequence
+static uint8_t    m_rx_crc_check;  // bytes to check, armed for next sequence
+static uint8_t    m_rx_crc_left;   // bytes left to end of checked block
+static bool       m_rx_crc_continue; // next sequence continues CRC8 and checked block
+static uint16_t   m_rx_crc_index;  // next received byte to update CRC8
+
+void owmh_rx_crc_check(uint8_t check_count)
+{
+#ifdef OW_HAL_STAGING
+	if (m_stage.armed)
+	{
+		// current operation can be in progress
+		m_stage.crc_check = check_count;
+		return;
+	}
+#endif
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_check = check_count;
+}
+
+void owmh_rx_crc_continue(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_rx_crc_continue = true;
+}
+
+uint8_t owmh_rx_crc8(void)
+{
+	return m_rx_crc8;
+}
+
+// CRC8 update up to m_slot_index. False, if checked block is completed with wrong CRC8.
+static bool owmh_rx_crc_update(void)
+{
+	uint16_t rx_bits = (m_slot_index > m_tx_count) ? (m_slot_index - m_tx_count) : 0;
+
+	while ((((uint32_t)m_rx_crc_index + 1) << 3) <= rx_bits)
+	{
+		m_rx_crc8 = crc8(m_rx_crc8, m_p_rx_buf[m_rx_crc_index++]);
+		if ((m_rx_crc_left > 0) && (--m_rx_crc_left == 0) && (m_rx_crc8 != 0))
+			return false;
+	}
+	return true;
+}
+#endif
+
+static void ow_uarte_irq_handler(void);
+static void ow_delay_timer_handler(void * p_context);
+
+static void ow_pins_config(uint32_t out_pin, uint32_t in_pin)
+{
+	nrf_gpio_cfg_input(in_pin, NRF_GPIO_PIN_NOPULL);
+	nrf_gpio_pin_set(out_pin);
+	nrf_gpio_cfg(out_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_S0D1,
+		NRF_GPIO_PIN_NOSENSE);
+}
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+static void ow_power_pin_config(uint32_t pwr_pin)
+{
+#if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
+	nrf_gpio_pin_clear(pwr_pin);
+#else
+	nrf_gpio_pin_set(pwr_pin);
+#endif
+	nrf_gpio_cfg(pwr_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_S0D1,
+		NRF_GPIO_PIN_NOSENSE);
+}
+#endif
+
+void owm_hal_initialize(owmh_callback_t callback)
+{
+	if (m_state != OWMHS_NOT_INITIALIZED)
+	{
+		APP_ERROR_CHECK(NRFX_ERROR_INVALID_STATE);
+	}
+
+#ifdef OW_HAL_STAGING
+	m_stage_callback = callback;
+	m_callback = owmh_stage_callback;
+#else
+	m_callback = callback;
+#endif
+
+	// init GPIO
+#ifdef OW_MULTI_CHANNEL
+	m_out_pin = ow_pins[0].tx_pin;
+	m_in_pin  = ow_pins[0].rx_pin;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	m_pwr_pin = ow_pins[0].pwr_pin;
+#endif
+
+	for (uint8_t k = 0; k < OW_CHANNEL_COUNT; ++k)
+	{
+		ow_pins_config(ow_pins[k].tx_pin, ow_pins[k].rx_pin);
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+		ow_power_pin_config(ow_pins[k].pwr_pin);
+#endif
+	}
+#else
+	m_out_pin = OW_OUT_PIN;
+	m_in_pin  = OW_IN_PIN;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	m_pwr_pin = OW_PWR_PIN;
+#endif
+	ow_pins_config(m_out_pin, m_in_pin);
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	ow_power_pin_config(m_pwr_pin);
+#endif
+#endif
+
+	// init UARTE. Pins keep open drain configuration, UARTE only drives them.
+	APP_ERROR_CHECK(nrfx_prs_acquire(ow_uarte, ow_uarte_irq_handler));
+
+	nrf_uarte_txrx_pins_set(ow_uarte, m_out_pin, m_in_pin);
+	nrf_uarte_configure(ow_uarte, NRF_UARTE_PARITY_EXCLUDED, NRF_UARTE_HWFC_DISABLED);
+	nrf_uarte_baudrate_set(ow_uarte, m_data_baudrate);
+
+	// Only end of reception is signalled. Echo of last transmitted byte
+	// is resieved after transmission completed, so it is end of transfer.
+	nrf_uarte_event_clear(ow_uarte, NRF_UARTE_EVENT_ENDRX);
+	nrf_uarte_event_clear(ow_uarte, NRF_UARTE_EVENT_ERROR);
+	nrf_uarte_shorts_enable(ow_uarte, NRF_UARTE_SHORT_ENDRX_STOPRX);
+	nrf_uarte_int_enable(ow_uarte, NRF_UARTE_INT_ENDRX_MASK);
+
+	NRFX_IRQ_PRIORITY_SET(nrfx_get_irq_number(ow_uarte), NRFX_UARTE_DEFAULT_CONFIG_IRQ_PRIORITY);
+	NRFX_IRQ_ENABLE(nrfx_get_irq_number(ow_uarte));
+
+	nrf_uarte_enable(ow_uarte);
+
+	// delays are timed by RTC based app_timer, app_timer_init() must be called by application
+	APP_ERROR_CHECK(app_timer_create(&m_ow_delay_timer, APP_TIMER_MODE_SINGLE_SHOT, ow_delay_timer_handler));
+
+	m_state = OWMHS_IDLE;
+}
+
+uint32_t owm_hal_uninitialize(void)
+{
+	if (m_state != OWMHS_IDLE) return 1;
+
+	// uninit UARTE
+	NRFX_IRQ_DISABLE(nrfx_get_irq_number(ow_uarte));
+	nrf_uarte_int_disable(ow_uarte, NRF_UARTE_INT_ENDRX_MASK);
+	nrf_uarte_shorts_disable(ow_uarte, NRF_UARTE_SHORT_ENDRX_STOPRX);
+	nrf_uarte_disable(ow_uarte);
+	nrf_uarte_txrx_pins_disconnect(ow_uarte);
+	nrfx_prs_release(ow_uarte);
+	/* Reset pins to default states */
+
+#ifdef OW_MULTI_CHANNEL
+	for (uint8_t k = 0; k < OW_CHANNEL_COUNT; ++k)
+	{
+		nrf_gpio_cfg_default(ow_pins[k].tx_pin);
+		nrf_gpio_cfg_default(ow_pins[k].rx_pin);
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+		nrf_gpio_cfg_default(ow_pins[k].pwr_pin);
+#endif
+	}
+#else
+	nrf_gpio_cfg_default(m_out_pin);
+	nrf_gpio_cfg_default(m_in_pin);
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+	nrf_gpio_cfg_default(m_pwr_pin);
+#endif
+#endif
+
+	m_state = OWMHS_NOT_INITIALIZED;
+	return 0;
+}
+
+#ifdef OW_MULTI_CHANNEL
+void ow_set_channel(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+#ifdef OW_BUS_FAULTS
+	m_channel = channel;
+#endif
+
+	if (m_out_pin != ow_pins[channel].tx_pin)
+	{
+		// PSEL registers can be changed only while UARTE is disabled
+		nrf_uarte_disable(ow_uarte);
+		m_out_pin = ow_pins[channel].tx_pin;
+		m_in_pin  = ow_pins[channel].rx_pin;
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_DEDICATED_POWER_PIN)))
+		m_pwr_pin = ow_pins[channel].pwr_pin;
+#endif
+		nrf_uarte_txrx_pins_set(ow_uarte, m_out_pin, m_in_pin);
+		nrf_uarte_enable(ow_uarte);
+	}
+}
+#endif // (defined (OW_MULTI_CHANNEL))
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+// Idle level of UART TX line is high, so strong pull-up is
+// just push-pull drive of out pin while no transfer in progress.
+static void ow_power_on()
+{
+#ifdef OW_DEDICATED_POWER_PIN
+#if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
+	nrf_gpio_pin_set(m_pwr_pin);
+#else
+	nrf_gpio_pin_clear(m_pwr_pin);
+#endif
+#else
+	nrf_gpio_cfg(m_out_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_D0H1,
+		NRF_GPIO_PIN_NOSENSE);
+#endif
+}
+
+static void ow_power_off()
+{
+#ifdef OW_HW_STRONG_PULLUP
+	m_pullup_hw = false;
+#endif
+#ifdef OW_DEDICATED_POWER_PIN
+#if (defined (OW_POWER_PIN_ACTIVE_STATE)&&(OW_POWER_PIN_ACTIVE_STATE == 1))
+	nrf_gpio_pin_clear(m_pwr_pin);
+#else
+	nrf_gpio_pin_set(m_pwr_pin);
+#endif
+#else
+	nrf_gpio_cfg(m_out_pin,
+		NRF_GPIO_PIN_DIR_OUTPUT,
+		NRF_GPIO_PIN_INPUT_DISCONNECT,
+		NRF_GPIO_PIN_NOPULL,
+		NRF_GPIO_PIN_S0D1,
+		NRF_GPIO_PIN_NOSENSE);
+#endif
+}
+#endif // (defined (OW_PARASITE_POWER_SUPPORT))
+
+// Launching of EasyDMA transfer. Receiver started first to catch echo of every transmitted byte.
+static void owmh_transfer(uint16_t count)
+{
+	nrf_uarte_event_clear(ow_uarte, NRF_UARTE_EVENT_ENDRX);
+	nrf_uarte_event_clear(ow_uarte, NRF_UARTE_EVENT_ERROR);
+	(void)nrf_uarte_errorsrc_get_and_clear(ow_uarte);
+
+	OWMH_ACTIVE_US(count * ((m_state == OWMHS_RESET) ? m_reset_byte_us : m_data_byte_us));
+	nrf_uarte_rx_buffer_set(ow_uarte, m_uart_rx_buf, count);
+	nrf_uarte_tx_buffer_set(ow_uarte, m_uart_tx_buf, count);
+	nrf_uarte_task_trigger(ow_uarte, NRF_UARTE_TASK_STARTRX);
+	nrf_uarte_task_trigger(ow_uarte, NRF_UARTE_TASK_STARTTX);
+}
+
+// Next part of sequence encoding and transmitting
+static void owmh_sequence_continue(void)
+{
+	m_dma_count = m_slot_count - m_slot_index;
+	if (m_dma_count > OW_UARTE_DMA_MAX_COUNT)
+		m_dma_count = OW_UARTE_DMA_MAX_COUNT;
+#ifdef OW_RX_CRC8
+	if (m_rx_crc_left > 0)
+	{
+		// part is ended on last slot of checked block
+		uint32_t check_end = m_tx_count + (((uint32_t)m_rx_crc_index + m_rx_crc_left) << 3);
+		if ((m_slot_index < check_end) && (m_dma_count > (check_end - m_slot_index)))
+			m_dma_count = check_end - m_slot_index;
+	}
+#endif
+	ow_uart_encode(m_uart_tx_buf, m_p_tx_buf, m_tx_count, m_slot_index, m_dma_count, m_bit_0);
+	owmh_transfer(m_dma_count);
+}
+
+#ifdef OW_BUS_FAULTS
+void owmh_fault_stats(uint8_t channel, owmh_fault_stats_t* p_stats, bool clear)
+{
+	APP_ERROR_CHECK_BOOL(channel < OW_FAULT_CHANNELS);
+	CRITICAL_REGION_ENTER();
+	ow_bus_fault_stats(&m_fault[channel], p_stats, clear);
+	CRITICAL_REGION_EXIT();
+}
+
+#ifdef OW_FAULT_QUARANTINE
+// Skip is completed by delay timer
+bool owmh_quarantine_skip(uint8_t channel)
+{
+	APP_ERROR_CHECK_BOOL((channel < OW_FAULT_CHANNELS) && (m_state == OWMHS_IDLE));
+	if (!ow_bus_fault_skip(&m_fault[channel]))
+		return false;
+	m_state = OWMHS_SKIP;
+	APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, APP_TIMER_MIN_TIMEOUT_TICKS, NULL));
+	return true;
+}
+#endif
+
+// Failed operation: line is held low at its end, or echo is corrupted
+static void owmh_fault_echo(void)
+{
+	if (!nrf_gpio_pin_read(m_in_pin))
+		ow_bus_fault_put(&m_fault[m_channel], OWMH_FAULT_NO_RELEASE);
+	else
+		ow_bus_fault_put(&m_fault[m_channel], (m_state == OWMHS_RESET) ? OWMH_FAULT_PRESENCE : OWMH_FAULT_TIMING);
+}
+#endif
+
+static void owmh_start(owmh_state_t state)
+{
+	if (!nrf_gpio_pin_read(m_in_pin))
+	{
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+		m_pullup_hw = false;
+#endif
+#ifdef OW_BUS_FAULTS
+		ow_bus_fault_put(&m_fault[m_channel], OWMH_FAULT_SHORT);
+#endif
+		m_callback(OWMHCR_ERROR);
+		return;
+	}
+#ifdef OW_BUS_FAULTS
+	ow_bus_fault_released(&m_fault[m_channel]);
+#endif
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)) && (!defined (OW_DEDICATED_POWER_PIN)))
+	if ((state == OWMHS_SEQUENCE) && (m_pullup_hw))
+	{
+		// UART drives line high between frames and after last stop bit,
+		// so strong drive of high level engages pull-up at end of last
+		// write slot without CPU. Devices do not drive line in write slots.
+		nrf_gpio_cfg(m_out_pin,
+			NRF_GPIO_PIN_DIR_OUTPUT,
+			NRF_GPIO_PIN_INPUT_DISCONNECT,
+			NRF_GPIO_PIN_NOPULL,
+			NRF_GPIO_PIN_S0H1,
+			NRF_GPIO_PIN_NOSENSE);
+	}
+#endif
+
+	m_state = state;
+	switch (state)
+	{
+	case OWMHS_RESET:
+		nrf_uarte_baudrate_set(ow_uarte, m_reset_baudrate);
+		m_uart_tx_buf[0] = OW_UART_RESET;
+		owmh_transfer(1);
+		break;
+
+	case OWMHS_WRITE:
+	case OWMHS_READ:
+	case OWMHS_READ_FLAG:
+		owmh_transfer(1);
+		break;
+
+	case OWMHS_SEQUENCE:
+		m_slot_index = 0;
+		owmh_sequence_continue();
+		break;
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_READ:
+		// direct and complement bits in one transfer, direction - in next one
+		m_dma_count = 2;
+		m_uart_tx_buf[0] = OW_UART_BIT_1;
+		m_uart_tx_buf[1] = OW_UART_BIT_1;
+		owmh_transfer(2);
+		break;
+#endif
+
+	case OWMHS_DELAY:
+#if (defined (OW_PARASITE_POWER_SUPPORT))
+	case OWMHS_POWER_HOLD:
+#endif
+		APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, APP_TIMER_TICKS(m_delay_counter), NULL));
+		break;
+
+	default: // OWMHS_IDLE, OWMHS_FLAG_PAUSE, OWMHS_NOT_INITIALIZED
+		APP_ERROR_CHECK_BOOL(false);
+	}
+}
+
+void owmh_reset(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	owmh_start(OWMHS_RESET);
+}
+
+void owmh_read(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_uart_tx_buf[0] = OW_UART_BIT_1;
+	owmh_start(OWMHS_READ);
+}
+
+void owmh_write(uint8_t bit)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_uart_tx_buf[0] = (bit) ? OW_UART_BIT_1 : m_bit_0;
+	owmh_start(OWMHS_WRITE);
+}
+
+#ifdef OW_ROM_SEARCH_SUPPORT
+void owmh_triplet(uint8_t direction)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_triplet = (direction) ? OWMH_TRIPLET_DIR : 0;
+	owmh_start(OWMHS_TRIPLET_READ);
+}
+#endif
+
+void owmh_sequence(uint8_t* p_txdata, uint8_t* p_rxdata, uint16_t tx_count, uint16_t rx_count)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	// timeslots of sequence are numbered by 16 bit index
+	APP_ERROR_CHECK_BOOL(((uint32_t)tx_count + rx_count) <= UINT16_MAX);
+	if ((!tx_count)&&(!rx_count)) return;
+	m_p_tx_buf = p_txdata;
+	m_p_rx_buf = p_rxdata;
+	m_tx_count = tx_count;
+	m_slot_count = (uint16_t)tx_count + rx_count;
+#ifdef OW_RX_CRC8
+	if (!m_rx_crc_continue)
+	{
+		m_rx_crc8 = 0;
+		m_rx_crc_left = m_rx_crc_check;
+	}
+	m_rx_crc_continue = false;
+	m_rx_crc_check = 0;
+	m_rx_crc_index = 0;
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)) && (!defined (OW_DEDICATED_POWER_PIN)))
+	m_pullup_hw = ((m_pullup_armed) && (rx_count == 0));
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	m_pullup_armed = false;
+#endif
+	owmh_start(OWMHS_SEQUENCE);
+}
+
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+// UARTE has no event at end of transmitted frame, dedicated power pin is
+// activated by owmh_hold_power() in this case.
+void owmh_arm_power(void)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_pullup_armed = true;
+}
+#endif
+
+#ifdef OW_OVERDRIVE_SUPPORT
+void owmh_set_speed(bool overdrive)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_reset_baudrate = (overdrive) ? OW_UARTE_BAUDRATE_RESET_OVERDRIVE : NRF_UARTE_BAUDRATE_9600;
+	m_data_baudrate  = (overdrive) ? NRF_UARTE_BAUDRATE_1000000 : NRF_UARTE_BAUDRATE_115200;
+	m_bit_0          = (overdrive) ? OW_UART_BIT_0_OVERDRIVE : OW_UART_BIT_0;
+#ifdef OW_HAL_ISR_COUNTER
+	m_reset_byte_us  = (overdrive) ? 150 : 1042;
+	m_data_byte_us   = (overdrive) ? 10 : 87;
+#endif
+	nrf_uarte_baudrate_set(ow_uarte, m_data_baudrate);
+}
+#endif
+
+void owmh_set_profile(uint8_t channel, owmh_profile_t profile)
+{
+	// timing of UART line coding is fixed by baudrates, profiles are not distinguished
+	UNUSED_PARAMETER(channel);
+	APP_ERROR_CHECK_BOOL(profile < OWMH_PROFILE_COUNT);
+}
+
+#ifdef OW_BUS_CALIBRATION
+// UART samples bus at fixed points of line coding, there is nothing to calibrate
+void owmh_calibrate(uint8_t channel)
+{
+	UNUSED_PARAMETER(channel);
+}
+
+bool owmh_calibrated(uint8_t channel)
+{
+	UNUSED_PARAMETER(channel);
+	return false;
+}
+#endif
+
+void owmh_wait_flag(uint16_t max_wait_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_delay_counter = max_wait_ms;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	ow_flag_poll_init(&m_flag_poll, max_wait_ms);
+#endif
+	m_uart_tx_buf[0] = OW_UART_BIT_1;
+	owmh_start(OWMHS_READ_FLAG);
+}
+
+void owmh_delay(uint16_t delay_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_delay_counter = delay_ms;
+	owmh_start(OWMHS_DELAY);
+}
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+void owmh_hold_power(uint16_t delay_ms)
+{
+	APP_ERROR_CHECK_BOOL(m_state == OWMHS_IDLE);
+	m_delay_counter = delay_ms;
+#ifdef OW_HW_STRONG_PULLUP
+	// pull-up can be already engaged by last sequence
+	m_pullup_armed = false;
+	if (!m_pullup_hw)
+#endif
+	ow_power_on();
+	owmh_start(OWMHS_POWER_HOLD);
+}
+#endif // defined (OW_PARASITE_POWER_SUPPORT)
+
+static void owmh_complete(owmh_callback_result_t result)
+{
+#ifdef OW_BUS_FAULTS
+	if (result == OWMHCR_ERROR)
+		owmh_fault_echo();
+#endif
+#if ((defined (OW_PARASITE_POWER_SUPPORT)) && (defined (OW_HW_STRONG_PULLUP)))
+	if ((result == OWMHCR_ERROR) && (m_pullup_hw))
+		ow_power_off();
+#endif
+	m_state = OWMHS_IDLE;
+	m_callback(result);
+}
+
+// UARTE interrupt handler (on ENDRX). Invoked once per transfer.
+static void ow_uarte_irq_handler(void)
+{
+	owmh_callback_result_t result = OWMHCR_ERROR;
+	bool     uart_error;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+	uint32_t pause;
+#endif
+
+	OWMH_ISR_COUNT();
+	if (!nrf_uarte_event_check(ow_uarte, NRF_UARTE_EVENT_ENDRX))
+		return;
+	nrf_uarte_event_clear(ow_uarte, NRF_UARTE_EVENT_ENDRX);
+	// echo is valid only after ENDRX
+	uint8_t  echo = m_uart_rx_buf[0];
+	nrf_uarte_task_trigger(ow_uarte, NRF_UARTE_TASK_STOPTX);
+
+	// Framing error means line was held low during stop bit
+	uart_error = nrf_uarte_event_check(ow_uarte, NRF_UARTE_EVENT_ERROR);
+#ifdef OW_ROM_SEARCH_SUPPORT
+	uart_error |= (nrf_uarte_rx_amount_get(ow_uarte) !=
+		(((m_state == OWMHS_SEQUENCE) || (m_state == OWMHS_TRIPLET_READ)) ? m_dma_count : 1));
+#else
+	uart_error |= (nrf_uarte_rx_amount_get(ow_uarte) != ((m_state == OWMHS_SEQUENCE) ? m_dma_count : 1));
+#endif
+
+	switch (m_state)
+	{
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_RESET :
+		nrf_uarte_baudrate_set(ow_uarte, m_data_baudrate);
+		result = ow_uart_decode_reset(echo);
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_WRITE:
+		if (echo == m_uart_tx_buf[0])
+			result = OWMHCR_WRITE_OK;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_READ:
+		if (ow_uart_echo_valid(echo))
+			result = (echo == OW_UART_BIT_1) ? OWMHCR_READ_1 : OWMHCR_READ_0;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+#ifdef OW_ROM_SEARCH_SUPPORT
+	case OWMHS_TRIPLET_READ:
+		if ((uart_error) || (!ow_uart_echo_valid(echo)) || (!ow_uart_echo_valid(m_uart_rx_buf[1])))
+			break;
+		if (echo == OW_UART_BIT_1)
+			m_triplet |= OWMH_TRIPLET_ID;
+		if (m_uart_rx_buf[1] == OW_UART_BIT_1)
+			m_triplet |= OWMH_TRIPLET_CMP;
+		// write direction: direct bit, if no discrepancy. Hint (already in DIR bit) at discrepancy
+		if ((m_triplet & OWMH_TRIPLET_ID) || (!(m_triplet & OWMH_TRIPLET_CMP) && (m_triplet & OWMH_TRIPLET_DIR)))
+			m_triplet |= OWMH_TRIPLET_DIR;
+		else
+			m_triplet &= (uint8_t)(~OWMH_TRIPLET_DIR);
+		m_uart_tx_buf[0] = (m_triplet & OWMH_TRIPLET_DIR) ? OW_UART_BIT_1 : m_bit_0;
+		m_state = OWMHS_TRIPLET_WRITE;
+		owmh_transfer(1);
+		return;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_TRIPLET_WRITE:
+		if (echo == m_uart_tx_buf[0])
+			result = (owmh_callback_result_t)(OWMHCR_TRIPLET | m_triplet);
+		break;
+//----------------------------------------------------------------------------------------------------------------
+#endif
+	case OWMHS_READ_FLAG :
+		if (!ow_uart_echo_valid(echo))
+			result = OWMHCR_ERROR;
+		else if (echo == OW_UART_BIT_1)
+			result = OWMHCR_FLAG_OK;
+#ifdef OW_PREDICTIVE_FLAG_POLL
+		else if ((pause = ow_flag_poll_next(&m_flag_poll, OW_FLAG_SLOT_US)) > 0)
+		{
+			m_state = OWMHS_FLAG_PAUSE;
+			APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, OW_APP_TIMER_TICKS_US(pause), NULL));
+			return;
+		}
+#else
+		else if (m_delay_counter > 0)
+		{
+			m_state = OWMHS_FLAG_PAUSE;
+			APP_ERROR_CHECK(app_timer_start(m_ow_delay_timer, APP_TIMER_TICKS(OW_FLAG_PAUSE_MS), NULL));
+			return;
+		}
+#endif
+		else
+			result = OWMHCR_TIME_OUT;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	case OWMHS_SEQUENCE :
+		if ((uart_error) || (!ow_uart_decode(m_uart_rx_buf, m_p_tx_buf, m_p_rx_buf,
+		                                     m_tx_count, m_slot_index, m_dma_count)))
+			break;
+		m_slot_index += m_dma_count;
+#ifdef OW_RX_CRC8
+		if (!owmh_rx_crc_update())
+		{
+			// rest of sequence is not transferred
+			result = OWMHCR_CRC_ERROR;
+			break;
+		}
+#endif
+		if (m_slot_index < m_slot_count)
+		{
+			// There are more timeslots to transfer
+			owmh_sequence_continue();
+			return;
+		}
+		result = OWMHCR_SEQUENCE_OK;
+		break;
+//----------------------------------------------------------------------------------------------------------------
+	default: // OWMHS_IDLE, OWMHS_NOT_INITIALIZED
+		APP_ERROR_CHECK_BOOL(false);
+//----------------------------------------------------------------------------------------------------------------
+	} // switch (m_state)
+
+	if (uart_error)
+		result = OWMHCR_ERROR;
+
+	owmh_complete(result);
+}
+
+// app_timer handler. Completion of delays and pauses between flag readings.
+static void ow_delay_timer_handler(void * p_context)
+{
+	UNUSED_PARAMETER(p_context);
+	OWMH_ISR_COUNT();
+
+	switch (m_state)
+	{
+	case OWMHS_FLAG_PAUSE :
+#ifndef OW_PREDICTIVE_FLAG_POLL
+		m_delay_counter -= (m_delay_counter > OW_FLAG_PAUSE_MS) ? OW_FLAG_PAUSE_MS : m_delay_counter;
+#endif
+		m_state = OWMHS_READ_FLAG;
+		m_uart_tx_buf[0] = OW_UART_BIT_1;
+		owmh_transfer(1);
+		break;
+
+	case OWMHS_DELAY :
+		owmh_complete(nrf_gpio_pin_read(m_in_pin) ? OWMHCR_WAIT_OK : OWMHCR_ERROR);
+		break;
+
+#ifdef OW_PARASITE_POWER_SUPPORT
+	case OWMHS_POWER_HOLD :
+		ow_power_off();
+		owmh_complete(OWMHCR_WAIT_OK);
+		break;
+#endif
+
+#ifdef OW_FAULT_QUARANTINE
+	case OWMHS_SKIP :
+		// line was not touched, no fault is counted
+		m_state = OWMHS_IDLE;
+		m_callback(OWMHCR_ERROR);
+		break;
+#endif
+
+	default: // any state with UARTE transfer in progress
+		APP_ERROR_CHECK_BOOL(false);
+	}
+}
+
+#endif // OW_HAL_UARTE
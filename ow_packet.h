@@ -20,16 +20,47 @@ extern "C" {
 #define	OWM_CMD_ALARM_SEARCH    0xEC    //*< address searching procedure for alarmed devices     */
 #endif
 
-//#define OWM_CMD_OVERDRIVE       = 0x3C,
-//#define OWM_CMD_MATCH_OVERDRIVE = 0x69,
+#ifdef OW_OVERDRIVE_SUPPORT
+// Overdrive is tracked per channel, not per device. Overdrive ROM commands are transmitted
+// after reset at standard speed and switch channel to overdrive. Packets of RESUME command
+// follow speed of channel. Other ROM commands are transmitted after reset at standard speed,
+// which returns all devices of channel from overdrive, unless overdrive_speed of packet is
+// set: then the packet addresses devices switched to overdrive before, and device of standard
+// speed does not respond to it.
+#define	OWM_CMD_OVERDRIVE       0x3C    //*< skip ROM, all overdrive capable devices switched    */
+#define	OWM_CMD_MATCH_OVERDRIVE 0x69    //*< match ROM, addressed device switched to overdrive   */
+#endif
+
+#if (defined (OW_DATA_SEGMENTS))
+// 1-wire data segment. Segments of packet are transferred in given order, every segment
+// from (or into) its own buffer, so data is not assembled in staging buffer. Transmitted
+// segment and following reseived one are transferred by one HAL sequence. CRC8 runs over
+// all reseived segments: rx_crc_check bytes are counted from first reseived segment, rx_crc8
+// is CRC8 of all of them. Reseived segments must be whole bytes.
+typedef struct
+{
+	uint8_t* p_buf;                       //*< ptr to segment data                               */
+	uint16_t count;                       //*< number of bits of segment                         */
+	bool     rx;                          //*< if true, bits are reseived into p_buf, otherwise  */
+} ow_segment_t;                           //*< transmitted from p_buf                            */
+#endif
 
 // 1-wire data struct
 typedef struct
 {
 	uint8_t* p_txbuf;                     //*< ptr to transmit data buffer                       */
 	uint8_t* p_rxbuf;                     //*< ptr to receive data buffer                        */
-	uint8_t tx_count;                     //*< number of bits to transmit                        */
-	uint8_t rx_count;                     //*< number of bits to reseive                         */
+	uint16_t tx_count;                    //*< number of bits to transmit                        */
+	uint16_t rx_count;                    //*< number of bits to reseive                         */
+#if (defined (OW_RX_CRC8))
+	uint8_t rx_crc_check;                 //*< if not 0, reading is aborted, if CRC8 of first    */
+	                                      //*< rx_crc_check bytes is wrong                       */
+	uint8_t rx_crc8;                      //*< CRC8 of received bytes, 0 if trailing CRC valid   */
+#endif
+#if (defined (OW_DATA_SEGMENTS))
+	ow_segment_t* p_segments;             //*< if not NULL, data is transferred by segments, and */
+	uint8_t segment_count;                //*< buffers and counts above are not used             */
+#endif
 } ow_packet_data_t;
 
 #ifdef OW_ROM_SEARCH_SUPPORT
@@ -90,6 +121,9 @@ typedef struct ow_packet_t
 #if (defined (OW_MULTI_CHANNEL))
 	uint8_t              channel;       //*< 1-wire channel for this packet                      */
 #endif
+#if (defined (OW_BROADCAST))
+	uint8_t              channel_mask;  //*< if not 0, packet is transferred on all channels of  */
+#endif                                  //*< mask at once, reached channels are left in mask     */
 	uint16_t delay_ms;                    //*< delay in milliseconds for hold power, wait flag   */
 	struct
 	{
@@ -97,6 +131,9 @@ typedef struct ow_packet_t
 #if (defined (OW_PARASITE_POWER_SUPPORT)) //*< before transfer completion                        */
 		uint8_t          hold_power : 1;  //*< if 1, hold power procedure will be performed      */
 #endif                                    //*< before transfer completion                        */
+#if (defined (OW_OVERDRIVE_SUPPORT))
+		uint8_t          overdrive_speed : 1; //*< if 1, standard ROM commands are transferred at */
+#endif                                    //*< overdrive speed of channel                        */
 	};
 	union
 	{
@@ -0,0 +1,575 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ow_config.h"
+
+#if ((defined (OW_HAL_SIM)) || (defined (OW_DS2482_SIM)))
+
+// platform dependent
+#include "app_error.h"
+#define  CHECK_ERROR_BOOL( bool_expresion ) APP_ERROR_CHECK_BOOL( bool_expresion )
+// end of platform dependent section
+
+#include "ow_sim.h"
+
+// ROM and DS18B20 function commands
+#define OW_SIM_CMD_READ_ROM         0x33
+#define OW_SIM_CMD_MATCH_ROM        0x55
+#define OW_SIM_CMD_SKIP_ROM         0xCC
+#define OW_SIM_CMD_SEARCH_ROM       0xF0
+#define OW_SIM_CMD_ALARM_SEARCH     0xEC
+#define OW_SIM_CMD_OVERDRIVE_SKIP   0x3C
+#define OW_SIM_CMD_OVERDRIVE_MATCH  0x69
+#define OW_SIM_CMD_CONVERT_T        0x44
+#define OW_SIM_CMD_WRITE_SCRATCHPAD 0x4E
+#define OW_SIM_CMD_READ_SCRATCHPAD  0xBE
+#define OW_SIM_CMD_COPY_SCRATCHPAD  0x48
+#define OW_SIM_CMD_RECALL_EEPROM    0xB8
+#define OW_SIM_CMD_READ_POWER       0xB4
+
+#define OW_SIM_DS18B20_FAMILY       0x28
+#define OW_SIM_CONVERT_9BIT_US      93750   // conversion time doubles per resolution bit
+#define OW_SIM_COPY_US              10000
+
+// scratchpad bytes
+#define OW_SIM_SP_TH                2
+#define OW_SIM_SP_CONFIG            4
+#define OW_SIM_SP_CRC               8
+
+/**
+ * Device states between timeslots
+ */
+typedef enum
+{
+	OW_SIM_IDLE,                    //*< not selected, waits for reset                        */
+	OW_SIM_ROM_COMMAND,             //*< receives ROM command after reset                     */
+	OW_SIM_MATCH,                   //*< compares ROM bits with written ones                  */
+	OW_SIM_SEARCH,                  //*< bit, complement, direction per ROM bit               */
+	OW_SIM_FUNCTION,                //*< receives function command                            */
+	OW_SIM_TRANSMIT,                //*< transmits ROM or scratchpad bits                     */
+	OW_SIM_RECEIVE,                 //*< receives TH, TL and config bytes                     */
+	OW_SIM_STATUS,                  //*< answers busy (0) or status bit in read slots         */
+} ow_sim_state_t;
+
+struct ow_sim_device_t
+{
+	uint8_t        rom[8];
+	uint8_t        scratchpad[9];
+	uint8_t        eeprom[3];       //*< TH, TL, config                                       */
+	int16_t        temperature;     //*< environment, latched by conversion                   */
+	uint8_t        options;         //*< OW_SIM_* options                                     */
+	uint8_t        channel;
+	bool           connected;
+	bool           overdrive;       //*< switched to overdrive speed                          */
+	bool           alarm;           //*< alarm flag of last conversion                        */
+	bool           converting;
+	ow_sim_state_t state;
+	ow_sim_state_t tx_next;         //*< state after transmitting                             */
+	const uint8_t* p_tx;
+	uint8_t        tx_bits;
+	uint8_t        bit_index;       //*< bit of ROM or transmitted data, received byte        */
+	uint8_t        search_phase;
+	uint8_t        rx_bits;
+	uint8_t        rx_byte;
+	uint8_t        status;          //*< status bit after busy time                           */
+	uint64_t       busy_end_us;
+	uint64_t       convert_end_us;
+	uint16_t       next;            //*< next device of channel + 1, 0 - last                 */
+};
+
+typedef struct
+{
+	uint64_t         time_us;
+	uint32_t         order;
+	ow_sim_handler_t handler;
+	void*            p_context;
+} ow_sim_event_t;
+
+static ow_sim_device_t m_devices[OW_SIM_DEVICE_COUNT];
+static uint16_t        m_device_count;
+static uint16_t        m_first_device[OW_SIM_CHANNEL_COUNT];  // device + 1, 0 - no devices
+static bool            m_shorted[OW_SIM_CHANNEL_COUNT];
+
+// event queue, binary heap ordered by time and order of scheduling
+static ow_sim_event_t  m_events[OW_SIM_EVENT_COUNT];
+static uint16_t        m_event_count;
+static uint32_t        m_event_order;
+static uint64_t        m_time_us;
+
+static ow_sim_stats_t  m_stats;
+
+static ow_sim_watch_handler_t m_watch_handler;   // HAL watching for attached devices
+
+//------------------------------------------ virtual clock --------------------------------------------
+
+void ow_sim_reset(void)
+{
+	memset(m_devices, 0, sizeof(m_devices));
+	m_device_count = 0;
+	for (uint8_t channel = 0; channel < OW_SIM_CHANNEL_COUNT; ++channel)
+	{
+		m_first_device[channel] = 0;
+		m_shorted[channel] = false;
+	}
+	m_event_count = 0;
+	m_event_order = 0;
+	m_time_us = 0;
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+uint64_t ow_sim_time_us(void)
+{
+	return m_time_us;
+}
+
+static bool ow_sim_event_before(const ow_sim_event_t* p_a, const ow_sim_event_t* p_b)
+{
+	if (p_a->time_us != p_b->time_us)
+		return (p_a->time_us < p_b->time_us);
+	return ((int32_t)(p_a->order - p_b->order) < 0);
+}
+
+void ow_sim_schedule(uint32_t delay_us, ow_sim_handler_t handler, void* p_context)
+{
+	uint16_t index = m_event_count++;
+
+	CHECK_ERROR_BOOL(m_event_count <= OW_SIM_EVENT_COUNT);
+	m_events[index].time_us   = m_time_us + delay_us;
+	m_events[index].order     = m_event_order++;
+	m_events[index].handler   = handler;
+	m_events[index].p_context = p_context;
+	// sift up
+	while (index > 0)
+	{
+		uint16_t       parent = (index - 1) / 2;
+		ow_sim_event_t event  = m_events[index];
+
+		if (!ow_sim_event_before(&event, &m_events[parent]))
+			break;
+		m_events[index]  = m_events[parent];
+		m_events[parent] = event;
+		index = parent;
+	}
+}
+
+bool ow_sim_step(void)
+{
+	ow_sim_event_t event;
+	uint16_t       index = 0;
+
+	if (m_event_count == 0)
+		return false;
+	event = m_events[0];
+	m_events[0] = m_events[--m_event_count];
+	// sift down
+	for (;;)
+	{
+		uint16_t       child = 2 * index + 1;
+		ow_sim_event_t swap;
+
+		if (child >= m_event_count)
+			break;
+		if (((child + 1) < m_event_count) && (ow_sim_event_before(&m_events[child + 1], &m_events[child])))
+			++child;
+		if (!ow_sim_event_before(&m_events[child], &m_events[index]))
+			break;
+		swap = m_events[index];
+		m_events[index] = m_events[child];
+		m_events[child] = swap;
+		index = child;
+	}
+	m_time_us = event.time_us;
+	event.handler(event.p_context);
+	return true;
+}
+
+void ow_sim_run(void)
+{
+	while (ow_sim_step())
+		;
+}
+
+void ow_sim_run_until(uint64_t time_us)
+{
+	while ((m_event_count > 0) && (m_events[0].time_us <= time_us))
+		ow_sim_step();
+	if (m_time_us < time_us)
+		m_time_us = time_us;
+}
+
+void ow_sim_stats(ow_sim_stats_t* p_stats, bool clear)
+{
+	*p_stats = m_stats;
+	if (clear)
+		memset(&m_stats, 0, sizeof(m_stats));
+}
+
+void ow_sim_account(ow_sim_op_t op, uint32_t duration_us, uint32_t slots)
+{
+	m_stats.op_time_us[op] += duration_us;
+	++m_stats.op_count[op];
+	m_stats.slots += slots;
+	m_stats.last_op_us = duration_us;
+}
+
+//--------------------------------------------- devices -----------------------------------------------
+
+static void ow_sim_scratchpad_crc(ow_sim_device_t* p_device)
+{
+	uint8_t crc = 0;
+
+	for (uint8_t k = 0; k < OW_SIM_SP_CRC; ++k)
+		docrc8(&crc, p_device->scratchpad[k]);
+	p_device->scratchpad[OW_SIM_SP_CRC] = crc;
+}
+
+ow_sim_device_t* ow_sim_ds18b20_add(uint8_t channel, uint64_t serial, uint8_t options)
+{
+	static const uint8_t power_on_scratchpad[OW_SIM_SP_CRC] = { 0x50, 0x05, 75, 70, 0x7F, 0xFF, 0x0C, 0x10 };
+	ow_sim_device_t*     p_device;
+
+	CHECK_ERROR_BOOL(channel < OW_SIM_CHANNEL_COUNT);
+	if (m_device_count >= OW_SIM_DEVICE_COUNT)
+		return NULL;
+	p_device = &m_devices[m_device_count];
+	memset(p_device, 0, sizeof(ow_sim_device_t));
+
+	p_device->rom[0] = OW_SIM_DS18B20_FAMILY;
+	for (uint8_t k = 0; k < 6; ++k)
+		p_device->rom[k + 1] = (uint8_t)(serial >> (8 * k));
+	for (uint8_t k = 0; k < 7; ++k)
+		docrc8(&p_device->rom[7], p_device->rom[k]);
+
+	memcpy(p_device->scratchpad, power_on_scratchpad, sizeof(power_on_scratchpad));
+	ow_sim_scratchpad_crc(p_device);
+	memcpy(p_device->eeprom, &p_device->scratchpad[OW_SIM_SP_TH], sizeof(p_device->eeprom));
+	p_device->temperature = 25 * 16;
+	p_device->options     = options;
+	p_device->channel     = channel;
+	p_device->connected   = true;
+	p_device->state       = OW_SIM_IDLE;
+
+	p_device->next = m_first_device[channel];
+	m_first_device[channel] = ++m_device_count;
+	return p_device;
+}
+
+void ow_sim_ds18b20_temperature(ow_sim_device_t* p_device, int16_t temperature)
+{
+	p_device->temperature = temperature;
+}
+
+void ow_sim_device_rom(const ow_sim_device_t* p_device, ROM_code_t* p_ROM_code)
+{
+	memcpy(p_ROM_code->raw, p_device->rom, sizeof(p_device->rom));
+}
+
+static void ow_sim_attached(void* p_context)
+{
+	ow_sim_device_t* p_device = (ow_sim_device_t*)p_context;
+
+	if ((p_device->connected) && (m_watch_handler))
+		m_watch_handler(p_device->channel);
+}
+
+void ow_sim_device_connect(ow_sim_device_t* p_device, bool connected)
+{
+	// device connected anew waits for reset and emits presence pulse
+	if ((connected) && (!p_device->connected))
+	{
+		p_device->state = OW_SIM_IDLE;
+		ow_sim_schedule(OW_SIM_ATTACH_PRESENCE_US, ow_sim_attached, p_device);
+	}
+	p_device->connected = connected;
+}
+
+void ow_sim_channel_short(uint8_t channel, bool shorted)
+{
+	CHECK_ERROR_BOOL(channel < OW_SIM_CHANNEL_COUNT);
+	m_shorted[channel] = shorted;
+}
+
+// Conversion result is latched at first access after conversion end
+static void ow_sim_ds18b20_update(ow_sim_device_t* p_device, uint64_t time_us)
+{
+	uint8_t resolution;
+	int8_t  degrees;
+
+	if ((!p_device->converting) || (time_us < p_device->convert_end_us))
+		return;
+	p_device->converting = false;
+	// undefined low bits of lower resolutions are 0
+	resolution = (p_device->scratchpad[OW_SIM_SP_CONFIG] >> 5) & 0x03;
+	p_device->scratchpad[0] = (uint8_t)p_device->temperature & (uint8_t)(0xFF << (3 - resolution));
+	p_device->scratchpad[1] = (uint8_t)((uint16_t)p_device->temperature >> 8);
+	ow_sim_scratchpad_crc(p_device);
+	degrees = (int8_t)(p_device->temperature >> 4);
+	p_device->alarm = ((degrees >= (int8_t)p_device->scratchpad[OW_SIM_SP_TH])
+		|| (degrees <= (int8_t)p_device->scratchpad[OW_SIM_SP_TH + 1]));
+}
+
+static void ow_sim_enter(ow_sim_device_t* p_device, ow_sim_state_t state)
+{
+	p_device->state        = state;
+	p_device->bit_index    = 0;
+	p_device->search_phase = 0;
+	p_device->rx_bits      = 0;
+}
+
+static void ow_sim_transmit(ow_sim_device_t* p_device, const uint8_t* p_data, uint8_t bits, ow_sim_state_t next)
+{
+	ow_sim_enter(p_device, OW_SIM_TRANSMIT);
+	p_device->p_tx    = p_data;
+	p_device->tx_bits = bits;
+	p_device->tx_next = next;
+}
+
+static void ow_sim_status(ow_sim_device_t* p_device, uint64_t busy_end_us, uint8_t status)
+{
+	ow_sim_enter(p_device, OW_SIM_STATUS);
+	p_device->busy_end_us = busy_end_us;
+	p_device->status      = status;
+}
+
+static uint8_t ow_sim_rom_bit(const ow_sim_device_t* p_device)
+{
+	return (p_device->rom[p_device->bit_index >> 3] >> (p_device->bit_index & 0x07)) & 0x01;
+}
+
+// Bits are received LSB first, true on completed byte
+static bool ow_sim_receive(ow_sim_device_t* p_device, uint8_t line)
+{
+	p_device->rx_byte = (uint8_t)((p_device->rx_byte >> 1) | (line << 7));
+	if (++p_device->rx_bits < 8)
+		return false;
+	p_device->rx_bits = 0;
+	return true;
+}
+
+static void ow_sim_rom_command(ow_sim_device_t* p_device, uint8_t command, uint64_t time_us)
+{
+	switch (command)
+	{
+	case OW_SIM_CMD_READ_ROM:
+		ow_sim_transmit(p_device, p_device->rom, 64, OW_SIM_FUNCTION);
+		break;
+
+	case OW_SIM_CMD_OVERDRIVE_MATCH:
+		if (!(p_device->options & OW_SIM_OVERDRIVE))
+		{
+			ow_sim_enter(p_device, OW_SIM_IDLE);
+			break;
+		}
+		// ROM address follows at overdrive speed
+		p_device->overdrive = true;
+		// no break
+	case OW_SIM_CMD_MATCH_ROM:
+		ow_sim_enter(p_device, OW_SIM_MATCH);
+		break;
+
+	case OW_SIM_CMD_OVERDRIVE_SKIP:
+		if (!(p_device->options & OW_SIM_OVERDRIVE))
+		{
+			ow_sim_enter(p_device, OW_SIM_IDLE);
+			break;
+		}
+		p_device->overdrive = true;
+		// no break
+	case OW_SIM_CMD_SKIP_ROM:
+		ow_sim_enter(p_device, OW_SIM_FUNCTION);
+		break;
+
+	case OW_SIM_CMD_ALARM_SEARCH:
+		ow_sim_ds18b20_update(p_device, time_us);
+		ow_sim_enter(p_device, (p_device->alarm) ? OW_SIM_SEARCH : OW_SIM_IDLE);
+		break;
+
+	case OW_SIM_CMD_SEARCH_ROM:
+		ow_sim_enter(p_device, OW_SIM_SEARCH);
+		break;
+
+	default:
+		ow_sim_enter(p_device, OW_SIM_IDLE);
+	}
+}
+
+static void ow_sim_function_command(ow_sim_device_t* p_device, uint8_t command, uint64_t time_us)
+{
+	bool parasite = ((p_device->options & OW_SIM_PARASITE) != 0);
+
+	ow_sim_ds18b20_update(p_device, time_us);
+	switch (command)
+	{
+	case OW_SIM_CMD_CONVERT_T:
+		p_device->converting = true;
+		p_device->convert_end_us = time_us +
+			((uint32_t)OW_SIM_CONVERT_9BIT_US << ((p_device->scratchpad[OW_SIM_SP_CONFIG] >> 5) & 0x03));
+		// parasite powered device can not pull line low while converting
+		ow_sim_status(p_device, (parasite) ? 0 : p_device->convert_end_us, 1);
+		break;
+
+	case OW_SIM_CMD_READ_SCRATCHPAD:
+		ow_sim_transmit(p_device, p_device->scratchpad, 72, OW_SIM_IDLE);
+		break;
+
+	case OW_SIM_CMD_WRITE_SCRATCHPAD:
+		ow_sim_enter(p_device, OW_SIM_RECEIVE);
+		break;
+
+	case OW_SIM_CMD_COPY_SCRATCHPAD:
+		memcpy(p_device->eeprom, &p_device->scratchpad[OW_SIM_SP_TH], sizeof(p_device->eeprom));
+		ow_sim_status(p_device, (parasite) ? 0 : (time_us + OW_SIM_COPY_US), 1);
+		break;
+
+	case OW_SIM_CMD_RECALL_EEPROM:
+		memcpy(&p_device->scratchpad[OW_SIM_SP_TH], p_device->eeprom, sizeof(p_device->eeprom));
+		ow_sim_scratchpad_crc(p_device);
+		ow_sim_status(p_device, 0, 1);
+		break;
+
+	case OW_SIM_CMD_READ_POWER:
+		ow_sim_status(p_device, 0, (parasite) ? 0 : 1);
+		break;
+
+	default:
+		ow_sim_enter(p_device, OW_SIM_IDLE);
+	}
+}
+
+// Level driven by device in timeslot, 1 - line released
+static uint8_t ow_sim_output(const ow_sim_device_t* p_device, uint64_t time_us)
+{
+	switch (p_device->state)
+	{
+	case OW_SIM_SEARCH:
+		if (p_device->search_phase == 0)
+			return ow_sim_rom_bit(p_device);
+		if (p_device->search_phase == 1)
+			return ow_sim_rom_bit(p_device) ^ 0x01;
+		return 1;
+
+	case OW_SIM_TRANSMIT:
+		return (p_device->p_tx[p_device->bit_index >> 3] >> (p_device->bit_index & 0x07)) & 0x01;
+
+	case OW_SIM_STATUS:
+		return (time_us >= p_device->busy_end_us) ? p_device->status : 0;
+
+	default:
+		return 1;
+	}
+}
+
+// Line level sampled by device in timeslot
+static void ow_sim_input(ow_sim_device_t* p_device, uint8_t line, uint64_t time_us)
+{
+	switch (p_device->state)
+	{
+	case OW_SIM_ROM_COMMAND:
+		if (ow_sim_receive(p_device, line))
+			ow_sim_rom_command(p_device, p_device->rx_byte, time_us);
+		break;
+
+	case OW_SIM_MATCH:
+		if (line != ow_sim_rom_bit(p_device))
+			ow_sim_enter(p_device, OW_SIM_IDLE);
+		else if (++p_device->bit_index == 64)
+			ow_sim_enter(p_device, OW_SIM_FUNCTION);
+		break;
+
+	case OW_SIM_SEARCH:
+		if (p_device->search_phase < 2)
+			++p_device->search_phase;
+		else if (line != ow_sim_rom_bit(p_device))
+			ow_sim_enter(p_device, OW_SIM_IDLE);     // other branch of search route
+		else if (++p_device->bit_index == 64)
+			ow_sim_enter(p_device, OW_SIM_FUNCTION);
+		else
+			p_device->search_phase = 0;
+		break;
+
+	case OW_SIM_FUNCTION:
+		if (ow_sim_receive(p_device, line))
+			ow_sim_function_command(p_device, p_device->rx_byte, time_us);
+		break;
+
+	case OW_SIM_TRANSMIT:
+		if (++p_device->bit_index == p_device->tx_bits)
+			ow_sim_enter(p_device, p_device->tx_next);
+		break;
+
+	case OW_SIM_RECEIVE:
+		if (!ow_sim_receive(p_device, line))
+			break;
+		// TH, TL, config. Only resolution bits of config are writable
+		if (p_device->bit_index == 2)
+			p_device->rx_byte = (p_device->rx_byte & 0x60) | 0x1F;
+		p_device->scratchpad[OW_SIM_SP_TH + p_device->bit_index] = p_device->rx_byte;
+		ow_sim_scratchpad_crc(p_device);
+		if (++p_device->bit_index == 3)
+			ow_sim_enter(p_device, OW_SIM_IDLE);
+		break;
+
+	default: // OW_SIM_IDLE, OW_SIM_STATUS
+		break;
+	}
+}
+
+//--------------------------------------------- bus model ---------------------------------------------
+
+void ow_sim_bus_watch(ow_sim_watch_handler_t handler)
+{
+	m_watch_handler = handler;
+}
+
+bool ow_sim_bus_shorted(uint8_t channel)
+{
+	return m_shorted[channel];
+}
+
+bool ow_sim_bus_reset(uint8_t channel, uint64_t time_us, bool overdrive)
+{
+	bool presence = false;
+
+	for (uint16_t link = m_first_device[channel]; link != 0; link = m_devices[link - 1].next)
+	{
+		ow_sim_device_t* p_device = &m_devices[link - 1];
+
+		if (!p_device->connected)
+			continue;
+		// standard speed reset returns all devices from overdrive,
+		// overdrive reset is too short for devices at standard speed
+		if (!overdrive)
+			p_device->overdrive = false;
+		else if (!p_device->overdrive)
+			continue;
+		ow_sim_ds18b20_update(p_device, time_us);
+		ow_sim_enter(p_device, OW_SIM_ROM_COMMAND);
+		presence = true;
+	}
+	return presence;
+}
+
+uint8_t ow_sim_bus_slot(uint8_t channel, uint8_t bit, uint64_t time_us, bool overdrive)
+{
+	uint8_t line = bit;
+
+	// wired AND of master and devices at speed of slot
+	for (uint16_t link = m_first_device[channel]; link != 0; link = m_devices[link - 1].next)
+	{
+		ow_sim_device_t* p_device = &m_devices[link - 1];
+
+		if ((p_device->connected) && (p_device->state != OW_SIM_IDLE) && (p_device->overdrive == overdrive))
+			line &= ow_sim_output(p_device, time_us);
+	}
+	for (uint16_t link = m_first_device[channel]; link != 0; link = m_devices[link - 1].next)
+	{
+		ow_sim_device_t* p_device = &m_devices[link - 1];
+
+		if ((p_device->connected) && (p_device->state != OW_SIM_IDLE) && (p_device->overdrive == overdrive))
+			ow_sim_input(p_device, line, time_us);
+	}
+	return line;
+}
+
+#endif // ((defined (OW_HAL_SIM)) || (defined (OW_DS2482_SIM)))
@@ -0,0 +1,193 @@
+#ifndef	OW_SIM_H__
+#define OW_SIM_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_config.h"
+#include "ow_packet.h"
+
+// 1-wire bus simulator for host builds (OW_HAL_SIM). Simulated HAL (ow_master_hal_sim.c)
+// drives multi-drop buses of virtual devices on discrete-event virtual clock, so ow_master,
+// ow_manager, search helpers and device drivers run on host without hardware.
+//
+// HAL operation is evaluated at its start: every timeslot is seen by devices at its virtual
+// time, completion callback is scheduled as event after bus time of operation. Application
+// drives the clock by ow_sim_step()/ow_sim_run(), other activity is scheduled by ow_sim_schedule().
+//
+// Devices are DS18B20 models: ROM commands (read, match, skip, search, alarm search,
+// overdrive if enabled), scratchpad, conversion timing of configured resolution,
+// alarm flags, EEPROM copy/recall and power supply reading.
+//
+// With OW_DS2482_SIM bus model is driven by DS2482 bridge model (ow_sim_ds2482.c)
+// under DS2482 HAL backend instead of simulated HAL.
+
+#ifndef OW_SIM_DEVICE_COUNT
+#define OW_SIM_DEVICE_COUNT     1024    //*< capacity of device pool                      */
+#endif
+#ifndef OW_SIM_EVENT_COUNT
+#define OW_SIM_EVENT_COUNT      32      //*< capacity of event queue                      */
+#endif
+#define OW_SIM_ATTACH_PRESENCE_US 150   //*< end of presence pulse after connecting       */
+
+#if (defined (OW_MULTI_CHANNEL))
+#define OW_SIM_CHANNEL_COUNT    OW_CHANNEL_COUNT
+#else
+#define OW_SIM_CHANNEL_COUNT    1
+#endif
+
+// Device options of ow_sim_ds18b20_add()
+#define OW_SIM_PARASITE         0x01    //*< parasite powered, can not signal busy state  */
+#define OW_SIM_OVERDRIVE        0x02    //*< responds to overdrive ROM commands           */
+
+/**
+ * Simulated HAL operations, accounted in statistics
+ */
+typedef enum
+{
+	OW_SIM_OP_RESET = 0,
+	OW_SIM_OP_WRITE,
+	OW_SIM_OP_READ,
+	OW_SIM_OP_TRIPLET,
+	OW_SIM_OP_SEQUENCE,
+	OW_SIM_OP_WAIT_FLAG,
+	OW_SIM_OP_DELAY,
+	OW_SIM_OP_HOLD_POWER,
+
+	OW_SIM_OP_COUNT
+} ow_sim_op_t;
+
+/**
+ * Bus time statistics
+ */
+typedef struct
+{
+	uint64_t op_time_us[OW_SIM_OP_COUNT];  //*< bus time per operation kind               */
+	uint32_t op_count[OW_SIM_OP_COUNT];    //*< operations per kind                       */
+	uint32_t slots;                        //*< data timeslots (reset excluded)           */
+	uint32_t last_op_us;                   //*< bus time of last operation                */
+} ow_sim_stats_t;
+
+typedef struct ow_sim_device_t ow_sim_device_t;
+typedef void(*ow_sim_handler_t)(void* p_context);
+
+// ------------------------------------- virtual clock ---------------------------------------
+
+/**
+ * @brief Simulator reset.
+ *
+ * Devices are removed, clock is set to 0, events and statistics are cleared.
+ */
+void ow_sim_reset(void);
+
+/**
+ * @brief Virtual time, microseconds.
+ */
+uint64_t ow_sim_time_us(void);
+
+/**
+ * @brief Event scheduling.
+ *
+ * Handler is invoked by ow_sim_step() at current time + delay_us. Events of the same
+ * time are invoked in order of scheduling.
+ */
+void ow_sim_schedule(uint32_t delay_us, ow_sim_handler_t handler, void* p_context);
+
+/**
+ * @brief Next event processing.
+ *
+ * Clock is advanced to time of next event, then event handler is invoked.
+ *
+ * @retval false  no events left.
+ */
+bool ow_sim_step(void);
+
+/**
+ * @brief Processing of events until queue is empty.
+ */
+void ow_sim_run(void);
+
+/**
+ * @brief Processing of events up to given time, then clock is advanced to it.
+ */
+void ow_sim_run_until(uint64_t time_us);
+
+/**
+ * @brief Bus time statistics.
+ *
+ * @param clear  if true, statistics is cleared after copying.
+ */
+void ow_sim_stats(ow_sim_stats_t* p_stats, bool clear);
+
+// ---------------------------------------- devices ------------------------------------------
+
+/**
+ * @brief DS18B20 connecting.
+ *
+ * ROM code is family 0x28, 48 bit serial and CRC8. Scratchpad has power-on values
+ * (85 C, TH 75, TL 70, 12 bit resolution).
+ *
+ * @param channel  1-wire channel (0 in single channel configuration).
+ * @param serial   serial number, lower 48 bits are used.
+ * @param options  OW_SIM_* options.
+ *
+ * @return device, NULL if device pool is full.
+ */
+ow_sim_device_t* ow_sim_ds18b20_add(uint8_t channel, uint64_t serial, uint8_t options);
+
+/**
+ * @brief Temperature of DS18B20 environment.
+ *
+ * Value is latched into scratchpad at end of next conversion.
+ *
+ * @param temperature  1/16 C units, as in temperature register.
+ */
+void ow_sim_ds18b20_temperature(ow_sim_device_t* p_device, int16_t temperature);
+
+/**
+ * @brief ROM code of device.
+ */
+void ow_sim_device_rom(const ow_sim_device_t* p_device, ROM_code_t* p_ROM_code);
+
+/**
+ * @brief Device connection state.
+ *
+ * Disconnected device keeps its state and does not respond. Device connected anew
+ * emits presence pulse (OW_SIM_ATTACH_PRESENCE_US later).
+ */
+void ow_sim_device_connect(ow_sim_device_t* p_device, bool connected);
+
+/**
+ * @brief Line of channel held low (short circuit).
+ *
+ * All operations on channel fail with OWMHCR_ERROR.
+ */
+void ow_sim_channel_short(uint8_t channel, bool shorted);
+
+// ------------------------------- bus model (simulated HAL) ---------------------------------
+
+// line of channel is held low
+bool ow_sim_bus_shorted(uint8_t channel);
+
+// reset slot at time_us, true if presence pulse detected
+bool ow_sim_bus_reset(uint8_t channel, uint64_t time_us, bool overdrive);
+
+// timeslot at time_us, master writes bit (1 for read slot), sampled line level returned
+uint8_t ow_sim_bus_slot(uint8_t channel, uint8_t bit, uint64_t time_us, bool overdrive);
+
+// operation accounting, data timeslots of operation included
+void ow_sim_account(ow_sim_op_t op, uint32_t duration_us, uint32_t slots);
+
+// presence pulse of device connected anew is reported to handler with its channel
+typedef void(*ow_sim_watch_handler_t)(uint8_t channel);
+void ow_sim_bus_watch(ow_sim_watch_handler_t handler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_SIM_H__
@@ -0,0 +1,253 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ow_config.h"
+
+#ifdef OW_DS2482_SIM
+
+#include "app_error.h"
+
+#include "ow_ds2482.h"
+#include "ow_sim.h"
+
+// DS2482 register model over simulated buses (ow_sim.h), I2C port of DS2482 HAL backend
+// in host builds. Written bytes of transfer are executed at once, 1-wire command is evaluated
+// on bus model at end of its write, then busy bit stays set for bridge timing of its slots.
+// Bytes read after repeated start reflect state at end of transfer, completion event is
+// scheduled after I2C time of transfer. DS2482-800 channel selection with OW_DS2482_800.
+
+static ow_ds2482_port_handler_t m_handler;
+static bool     m_transfer;       // I2C transfer in progress
+static uint8_t  m_status;         // status register without busy bit
+static uint8_t  m_config;
+static uint8_t  m_data;
+static uint8_t  m_channel;
+static uint8_t  m_pointer;
+static uint64_t m_busy_until;     // end of 1-wire command
+
+static void ow_sim_ds2482_device_reset(void)
+{
+	m_status     = OW_DS2482_STATUS_RST | OW_DS2482_STATUS_LL;
+	m_config     = 0;
+	m_data       = 0;
+	m_channel    = 0;
+	m_pointer    = OW_DS2482_PTR_STATUS;
+	m_busy_until = 0;
+}
+
+void ow_ds2482_port_init(ow_ds2482_port_handler_t handler)
+{
+	m_handler  = handler;
+	m_transfer = false;
+	ow_sim_ds2482_device_reset();
+}
+
+void ow_ds2482_port_uninit(void)
+{
+	APP_ERROR_CHECK_BOOL(!m_transfer);
+}
+
+// Channels above simulated ones are lines without devices
+static bool ow_sim_ds2482_shorted(void)
+{
+	return (m_channel < OW_SIM_CHANNEL_COUNT) && (ow_sim_bus_shorted(m_channel));
+}
+
+static uint8_t ow_sim_ds2482_slot(uint8_t bit, uint64_t time_us)
+{
+	if (ow_sim_ds2482_shorted())
+		return 0;
+	if (m_channel >= OW_SIM_CHANNEL_COUNT)
+		return bit;
+	return ow_sim_bus_slot(m_channel, bit, time_us, (m_config & OW_DS2482_CONFIG_1WS) != 0);
+}
+
+// 1-wire command at time_us. Status keeps RST bit, line level is set after command.
+static void ow_sim_ds2482_1wire(uint8_t command, uint8_t parameter, uint64_t time_us)
+{
+	bool     overdrive = ((m_config & OW_DS2482_CONFIG_1WS) != 0);
+	uint16_t slot_us = (overdrive) ? OW_DS2482_SLOT_OD_US : OW_DS2482_SLOT_US;
+	uint8_t  status = m_status & OW_DS2482_STATUS_RST;
+	uint32_t duration_us;
+	uint8_t  id, cmp, dir;
+
+	// command issued while bridge is busy is not executed by real device
+	APP_ERROR_CHECK_BOOL(time_us >= m_busy_until);
+	switch (command)
+	{
+	case OW_DS2482_1WRS:
+		duration_us = (overdrive) ? OW_DS2482_RESET_OD_US : OW_DS2482_RESET_US;
+		if (ow_sim_ds2482_shorted())
+			status |= OW_DS2482_STATUS_SD;
+		else if ((m_channel < OW_SIM_CHANNEL_COUNT) && (ow_sim_bus_reset(m_channel, time_us, overdrive)))
+			status |= OW_DS2482_STATUS_PPD;
+		ow_sim_account(OW_SIM_OP_RESET, duration_us, 0);
+		break;
+
+	case OW_DS2482_1WSB:
+		duration_us = slot_us;
+		if (ow_sim_ds2482_slot((parameter & 0x80) ? 1 : 0, time_us))
+			status |= OW_DS2482_STATUS_SBR;
+		ow_sim_account((parameter & 0x80) ? OW_SIM_OP_READ : OW_SIM_OP_WRITE, duration_us, 1);
+		break;
+
+	case OW_DS2482_1WWB:
+	case OW_DS2482_1WRB:
+		duration_us = 8 * slot_us;
+		if (command == OW_DS2482_1WRB)
+		{
+			m_data = 0;
+			for (uint8_t k = 0; k < 8; ++k)
+				m_data |= (uint8_t)(ow_sim_ds2482_slot(1, time_us + k * slot_us) << k);
+		}
+		else
+			for (uint8_t k = 0; k < 8; ++k)
+				ow_sim_ds2482_slot((parameter >> k) & 0x01, time_us + k * slot_us);
+		ow_sim_account(OW_SIM_OP_SEQUENCE, duration_us, 8);
+		break;
+
+	case OW_DS2482_1WT:
+		// direct bit, if no discrepancy. Direction parameter at discrepancy
+		duration_us = 3 * slot_us;
+		id  = ow_sim_ds2482_slot(1, time_us);
+		cmp = ow_sim_ds2482_slot(1, time_us + slot_us);
+		dir = ((id) || ((!cmp) && (parameter & 0x80))) ? 1 : 0;
+		ow_sim_ds2482_slot(dir, time_us + 2 * slot_us);
+		status |= ((id) ? OW_DS2482_STATUS_SBR : 0) | ((cmp) ? OW_DS2482_STATUS_TSB : 0) |
+			((dir) ? OW_DS2482_STATUS_DIR : 0);
+		ow_sim_account(OW_SIM_OP_TRIPLET, duration_us, 3);
+		break;
+
+	default:
+		return;
+	}
+	if (!ow_sim_ds2482_shorted())
+		status |= OW_DS2482_STATUS_LL;
+	m_status     = status;
+	m_busy_until = time_us + duration_us;
+	m_pointer    = OW_DS2482_PTR_STATUS;
+}
+
+// Written bytes of transfer. False, if command is not acknowledged.
+static bool ow_sim_ds2482_write(const uint8_t* p_tx, uint8_t tx_length, uint64_t time_us)
+{
+	uint8_t parameter = (tx_length > 1) ? p_tx[1] : 0;
+
+	switch (p_tx[0])
+	{
+	case OW_DS2482_DRST:
+		ow_sim_ds2482_device_reset();
+		return (tx_length == 1);
+
+	case OW_DS2482_SRP:
+		if ((tx_length != 2) || ((parameter != OW_DS2482_PTR_STATUS) && (parameter != OW_DS2482_PTR_DATA) &&
+		                         (parameter != OW_DS2482_PTR_CONFIG) && (parameter != OW_DS2482_PTR_CHANNEL)))
+			return false;
+		m_pointer = parameter;
+		return true;
+
+	case OW_DS2482_WCFG:
+		if (tx_length != 2)
+			return false;
+		// configuration with wrong complement is not written
+		if ((parameter >> 4) == ((~parameter) & 0x0F))
+		{
+			m_config = parameter & 0x0F;
+			m_status &= (uint8_t)(~OW_DS2482_STATUS_RST);
+		}
+		m_pointer = OW_DS2482_PTR_CONFIG;
+		return true;
+
+#ifdef OW_DS2482_800
+	case OW_DS2482_CHSL:
+		if (tx_length != 2)
+			return false;
+		for (uint8_t k = 0; k < OW_DS2482_CHANNELS; ++k)
+			if (ow_ds2482_channel_code[k] == parameter)
+				m_channel = k;
+		m_pointer = OW_DS2482_PTR_CHANNEL;
+		return true;
+#endif
+
+	case OW_DS2482_1WRS:
+	case OW_DS2482_1WRB:
+		if (tx_length != 1)
+			return false;
+		ow_sim_ds2482_1wire(p_tx[0], 0, time_us);
+		return true;
+
+	case OW_DS2482_1WSB:
+	case OW_DS2482_1WWB:
+	case OW_DS2482_1WT:
+		if (tx_length != 2)
+			return false;
+		ow_sim_ds2482_1wire(p_tx[0], parameter, time_us);
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+static uint8_t ow_sim_ds2482_read(uint64_t time_us)
+{
+	switch (m_pointer)
+	{
+	case OW_DS2482_PTR_DATA:
+		return m_data;
+	case OW_DS2482_PTR_CONFIG:
+		return m_config;
+	case OW_DS2482_PTR_CHANNEL:
+		return ow_ds2482_channel_readback[m_channel];
+	default: // OW_DS2482_PTR_STATUS
+		return m_status | ((time_us < m_busy_until) ? OW_DS2482_STATUS_1WB : 0);
+	}
+}
+
+static void ow_sim_ds2482_done(void* p_context)
+{
+	(void)p_context;
+	m_transfer = false;
+	m_handler(OW_DS2482_PORT_DONE);
+}
+
+static void ow_sim_ds2482_nack(void* p_context)
+{
+	(void)p_context;
+	m_transfer = false;
+	m_handler(OW_DS2482_PORT_NACK);
+}
+
+static void ow_sim_ds2482_timer(void* p_context)
+{
+	(void)p_context;
+	m_handler(OW_DS2482_PORT_TIMER);
+}
+
+void ow_ds2482_port_transfer(uint8_t* p_tx, uint8_t tx_length, uint8_t* p_rx, uint8_t rx_length)
+{
+	uint64_t time_us = ow_sim_time_us();
+	uint32_t duration_us = ow_ds2482_twi_us(tx_length, rx_length);
+	bool     ack = true;
+
+	APP_ERROR_CHECK_BOOL((!m_transfer) && ((tx_length) || (rx_length)));
+	m_transfer = true;
+	if (tx_length)
+		ack = ow_sim_ds2482_write(p_tx, tx_length, time_us + ow_ds2482_twi_us(tx_length, 0));
+	for (uint8_t k = 0; (ack) && (k < rx_length); ++k)
+		p_rx[k] = ow_sim_ds2482_read(time_us + duration_us);
+	ow_sim_schedule(duration_us, (ack) ? ow_sim_ds2482_done : ow_sim_ds2482_nack, NULL);
+}
+
+// pauses of HAL are accounted as delays, except of time of 1-wire command in progress
+void ow_ds2482_port_timer(uint32_t delay_us)
+{
+	uint64_t time_us = ow_sim_time_us();
+	uint64_t start_us = (m_busy_until > time_us) ? m_busy_until : time_us;
+
+	if (time_us + delay_us > start_us)
+		ow_sim_account(OW_SIM_OP_DELAY, (uint32_t)(time_us + delay_us - start_us), 0);
+	ow_sim_schedule(delay_us, ow_sim_ds2482_timer, NULL);
+}
+
+#endif // OW_DS2482_SIM
@@ -0,0 +1,37 @@
+#include "ow_config.h"
+#include "ow_trace.h"
+
+#ifdef OW_TRACE
+
+ow_trace_t ow_trace =
+{
+	.header =
+	{
+		.magic = OW_TRACE_MAGIC,
+		.size  = OW_TRACE,
+	}
+};
+
+uint32_t ow_trace_read(uint32_t* p_position, ow_trace_record_t* p_records, uint32_t count)
+{
+	uint32_t head     = ow_trace.header.head;
+	uint32_t position = *p_position;
+	uint32_t copied   = 0;
+
+	if ((head - position) > OW_TRACE)
+		position = head - OW_TRACE;        // oldest records are lost
+	for (; (copied < count) && ((position + copied) != head); ++copied)
+		p_records[copied] = ow_trace.records[(position + copied) & (OW_TRACE - 1)];
+
+	// records overwritten while copying can be torn
+	head = ow_trace.header.head;
+	if ((head - position) > OW_TRACE)
+	{
+		*p_position = head - OW_TRACE;
+		return 0;
+	}
+	*p_position = position + copied;
+	return copied;
+}
+
+#endif // OW_TRACE
@@ -0,0 +1,107 @@
+#ifndef	OW_TRACE_H__
+#define OW_TRACE_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bus trace. TIMER HAL records every primitive, timeslot and result into ring buffer
+// ow_trace (flight recorder, oldest records are overwritten). Writing a record costs
+// a few stores, so trace can be left enabled in production builds. Ring buffer is read
+// by ow_trace_read() or dumped from RAM as is (debugger, nrfjprog) and converted to VCD
+// by tools/ow_trace_vcd.c. This header is shared with host tools.
+
+#define OW_TRACE_MAGIC          0x5254574F  //*< "OWTR"                                        */
+#define OW_TRACE_CLOCK_HZ       64000000    //*< time of records, CPU cycle counter (DWT)      */
+#define OW_TRACE_EDGE_HZ        16000000    //*< edge of records, HAL timer ticks              */
+
+/**
+ * Trace record events
+ */
+typedef enum
+{
+	OW_TRACE_RESET = 0,       //*< reset slot strobed at time, edge - rising edge of line  */
+	OW_TRACE_WRITE0,          //*< write 0 slot                                         */
+	OW_TRACE_SLOT1,           //*< write 1 or read slot                                 */
+	OW_TRACE_OP,              //*< HAL primitive started, edge - OW_TRACE_OP_*          */
+	OW_TRACE_DONE,            //*< primitive completed, edge - owmh_callback_result_t   */
+	OW_TRACE_FAIL,            //*< primitive failed, edge - owmh_callback_result_t      */
+} ow_trace_event_t;
+
+// HAL primitives of OW_TRACE_OP records
+#define OW_TRACE_OP_RESET       0
+#define OW_TRACE_OP_WRITE       1
+#define OW_TRACE_OP_READ        2
+#define OW_TRACE_OP_TRIPLET     3
+#define OW_TRACE_OP_SEQUENCE    4
+#define OW_TRACE_OP_WAIT_FLAG   5
+#define OW_TRACE_OP_DELAY       6
+#define OW_TRACE_OP_HOLD_POWER  7
+
+typedef struct
+{
+	uint32_t time;            //*< OW_TRACE_CLOCK_HZ cycles, wraps around              */
+	uint16_t edge;            //*< slot: rising edge from strobe, OW_TRACE_EDGE_HZ ticks */
+	uint8_t  event;           //*< ow_trace_event_t                                     */
+	uint8_t  channel;         //*< 1-wire channel (0 in single channel configuration)   */
+} ow_trace_record_t;
+
+// Header of ring buffer in RAM, followed by size records. Record of position p
+// is records[p % size], records from head - size (or 0) to head are valid.
+typedef struct
+{
+	uint32_t magic;           //*< OW_TRACE_MAGIC                                       */
+	uint32_t size;            //*< records in ring buffer, power of 2                   */
+	volatile uint32_t head;   //*< records written since start                          */
+	uint32_t reserved;
+} ow_trace_header_t;
+
+#ifdef OW_TRACE
+#if ((OW_TRACE & (OW_TRACE - 1)) != 0)
+#error "OW_TRACE: size of trace buffer must be power of 2"
+#endif
+
+typedef struct
+{
+	ow_trace_header_t header;
+	ow_trace_record_t records[OW_TRACE];
+} ow_trace_t;
+
+extern ow_trace_t ow_trace;
+
+// Record writing. Lock-free single producer: writers must not preempt each other
+// (1-wire interrupts of all bus groups at one priority).
+static inline void ow_trace_put(uint32_t time, uint32_t edge, ow_trace_event_t event, uint8_t channel)
+{
+	uint32_t head = ow_trace.header.head;
+	ow_trace_record_t* p_record = &ow_trace.records[head & (OW_TRACE - 1)];
+
+	p_record->time    = time;
+	p_record->edge    = (edge > UINT16_MAX) ? UINT16_MAX : (uint16_t)edge;
+	p_record->event   = (uint8_t)event;
+	p_record->channel = channel;
+	ow_trace.header.head = head + 1;
+}
+
+/**
+ * @brief Reading of trace records.
+ *
+ * Records from position are copied, position is advanced. If records at position
+ * were overwritten, reading continues from oldest record.
+ *
+ * @param p_position  position of next record to read (0 at start).
+ * @param p_records   buffer for records.
+ * @param count       capacity of buffer, records.
+ *
+ * @return number of copied records.
+ */
+uint32_t ow_trace_read(uint32_t* p_position, ow_trace_record_t* p_records, uint32_t count);
+#endif // OW_TRACE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_TRACE_H__
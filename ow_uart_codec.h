@@ -0,0 +1,117 @@
+#ifndef	OW_UART_CODEC_H__
+#define OW_UART_CODEC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ow_master_hal.h"
+
+// 1-wire over UART line coding. TX and RX pins of UART are both connected to 1-wire data line,
+// every transmitted UART byte is echoed back by receiver, so bus state is sampled by UART itself.
+//
+// Reset slot - 9600 baud. 0xF0 byte holds line low for start bit + 4 bits (520 us), then releases it.
+// Presence pulse of device corrupts high nibble of echo.
+//
+// Data slots - 115200 baud. Start bit (8.7 us) is 1-wire strobe, 0x00 holds line low for 78 us
+// (write 0), 0xFF releases line after start bit (write 1 or read slot). Device answering 0 in read
+// slot holds line low beyond start bit, so echo differs from 0xFF.
+//
+// Overdrive - reset at ~66.6 kBd (75 us pulse), data slots at 1 MBd. Write 0 slot is 0x80: 8 us low,
+// then last data bit and stop bit give 2 us of recovery time.
+
+#define OW_UART_RESET           0xF0    //*< reset pulse and presence detection zone (9600 baud)  */
+#define OW_UART_BIT_0           0x00    //*< write 0 slot (115200 baud)                           */
+#define OW_UART_BIT_1           0xFF    //*< write 1 and read slots (115200 baud)                 */
+#define OW_UART_BIT_0_OVERDRIVE 0x80    //*< write 0 slot in overdrive (1M baud)                  */
+
+// Echo of data slot is valid if line was low continuously from start bit, then released
+// (device can only prolong low level). Any other form means noise on line.
+static inline bool ow_uart_echo_valid(uint8_t echo)
+{
+	uint8_t low_bits = (uint8_t)(~echo);
+	return ((low_bits & (uint8_t)(low_bits + 1)) == 0);
+}
+
+/**
+ * @brief Reset slot echo decoding.
+ *
+ * @retval OWMHCR_RESET_OK          presence pulse detected.
+ * @retval OWMHCR_RESET_NO_RESPONCE echo matches transmitted byte.
+ * @retval OWMHCR_ERROR             line is not released at end of slot or reset pulse was shortened.
+ */
+static inline owmh_callback_result_t ow_uart_decode_reset(uint8_t echo)
+{
+	if (((echo & 0x80) == 0) || ((echo & 0x0F) != 0))
+		return OWMHCR_ERROR;
+	return (echo == OW_UART_RESET) ? OWMHCR_RESET_NO_RESPONCE : OWMHCR_RESET_OK;
+}
+
+/**
+ * @brief Encoding of sequence timeslots into UART bytes.
+ *
+ * Sequence consists of tx_count write slots followed by read slots. Slots from first_slot
+ * to first_slot + slot_count are encoded, so long sequences can be transferred in parts.
+ * bit_0 - code of write 0 slot for current bus speed.
+ */
+static inline void ow_uart_encode(uint8_t* p_uart_buf, const uint8_t* p_txdata, uint16_t tx_count,
+                                  uint16_t first_slot, uint16_t slot_count, uint8_t bit_0)
+{
+	for (uint16_t k = 0; k < slot_count; ++k)
+	{
+		uint16_t slot = first_slot + k;
+		if ((slot < tx_count) && (!(p_txdata[slot >> 3] & (1 << (slot & 0x07)))))
+			p_uart_buf[k] = bit_0;
+		else
+			p_uart_buf[k] = OW_UART_BIT_1;
+	}
+}
+
+/**
+ * @brief Decoding of sequence timeslots from UART echo.
+ *
+ * Echo of write slots is checked against transmitted data, read slots are stored to p_rxdata.
+ *
+ * @retval true   success.
+ * @retval false  incorrect signal on bus detected.
+ */
+static inline bool ow_uart_decode(const uint8_t* p_uart_buf, const uint8_t* p_txdata, uint8_t* p_rxdata,
+                                  uint16_t tx_count, uint16_t first_slot, uint16_t slot_count)
+{
+	for (uint16_t k = 0; k < slot_count; ++k)
+	{
+		uint16_t slot = first_slot + k;
+		uint8_t  echo = p_uart_buf[k];
+
+		if (!ow_uart_echo_valid(echo))
+			return false;
+
+		if (slot < tx_count)
+		{
+			// bit was transmitted. Echo must be the same as transmitted byte
+			bool tx_bit = ((p_txdata[slot >> 3] & (1 << (slot & 0x07))) != 0);
+			if (tx_bit != (echo == OW_UART_BIT_1))
+				return false;
+		}
+		else
+		{
+			// bit was resieved
+			uint16_t rx_slot = slot - tx_count;
+			uint8_t  mask = (uint8_t)(1 << (rx_slot & 0x07));
+			if (echo == OW_UART_BIT_1)
+				p_rxdata[rx_slot >> 3] |= mask;
+			else
+				p_rxdata[rx_slot >> 3] &= (uint8_t)(~mask);
+		}
+	}
+	return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OW_UART_CODEC_H__
@@ -0,0 +1,77 @@
+#ifndef	OW_CONFIG_H__
+#define OW_CONFIG_H__
+
+//---------------------------------------------------------------------
+//          1-wire master driver configuration, host simulation
+//---------------------------------------------------------------------
+
+// simulated HAL backend, see ow_sim.h. With OW_DS2482_SIM (ow_sim_ds2482_benchmark)
+// DS2482-800 bridge backend runs over register model of bridge
+#ifdef OW_DS2482_SIM
+#define OW_HAL_DS2482
+#define OW_DS2482_800
+#define OW_HW_STRONG_PULLUP
+#else
+#define OW_HAL_SIM
+#endif
+
+// capacity of simulated device pool
+#define OW_SIM_DEVICE_COUNT 1024
+
+// if defined, HAL counts completed operations and bus time (I2C time of DS2482 backend)
+// (owmh_isr_count(), owmh_active_time_us())
+#define OW_HAL_ISR_COUNTER
+
+// if defined, failed operations are classified and counted per channel (ow_channel_fault_stats())
+#define OW_BUS_FAULTS
+
+// if defined, persistently shorted channel is quarantined and probed with back-off
+#define OW_FAULT_QUARANTINE 4
+
+// if defined, HAL maintains CRC8 of received bytes (packet data.rx_crc8).
+// Reading is aborted, as soon as CRC8 of first data.rx_crc_check bytes fails
+#define OW_RX_CRC8
+
+// if defined, reset slot is finished given recovery time (us) after end of presence pulse
+//#define OW_RESET_EARLY_EXIT 15
+
+// if defined, read and write slots are finished given recovery time (us) after release edge
+//#define OW_SLOT_EARLY_END 5
+
+// if defined, presence pulse of device attached to idle channel is reported
+// (ow_channel_hot_plug_arm()). Not supported by DS2482 backend
+#ifdef OW_HAL_SIM
+#define OW_HOT_PLUG
+#endif
+
+// if defined, next sequence is staged in HAL and started at completion of current operation
+#define OW_HAL_STAGING
+
+// if defined, packet data can be given as list of transmitted and reseived segments
+// (data.p_segments), every segment with own buffer and bit count
+#define OW_DATA_SEGMENTS
+
+// 1-wire manager packet queue capacity
+#define OW_MANAGER_FIFO_SIZE 16
+
+// if not defined, driver functions for ROM searching excluded
+#define OW_ROM_SEARCH_SUPPORT
+
+// if not defined, driver functions for parasite power support excluded
+#define OW_PARASITE_POWER_SUPPORT
+
+// if defined, ready flag is polled densely only around expected completion time
+//#define OW_PREDICTIVE_FLAG_POLL
+
+// if defined, overdrive speed supported (OVERDRIVE SKIP / MATCH ROM commands)
+//#define OW_OVERDRIVE_SUPPORT
+
+// if defined, driver supports several channels
+#define OW_MULTI_CHANNEL
+
+#ifdef OW_MULTI_CHANNEL
+// number of channels (simulated buses)
+#define OW_CHANNEL_COUNT 4
+#endif
+
+#endif // OW_CONFIG_H__
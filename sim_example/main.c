@@ -0,0 +1,382 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ow_manager.h"
+#include "ow_master_hal.h"
+#include "ow_search_helpers.h"
+#include "ow_sim.h"
+#include "ds18b20.h"
+
+// Benchmark of 1-wire stack over simulated buses. DS18B20 models with random ROM codes
+// and temperatures are spread over channels, then sensors are discovered by ROM search,
+// configured, converted by one command per channel and read one by one (also by data
+// segments). Results are checked against models. Every phase reports its elapsed time and
+// operation time per sensor: time of 1-wire operations on all channels, which overlap in
+// elapsed time when channels run in parallel.
+
+#define SENSORS_DEFAULT_COUNT   200
+#define SENSORS_MAX_COUNT       OW_SIM_DEVICE_COUNT
+
+#define DS18B20_RESOL           RES_12_BIT
+#define ALARM_LOW               0
+#define ALARM_HIGH              30
+
+// owmh_active_time_us() of DS2482 backend counts I2C transfers, not 1-wire bus time
+#ifdef OW_DS2482_SIM
+#define HAL_TIME_LABEL          "I2C time"
+#else
+#define HAL_TIME_LABEL          "bus time"
+#endif
+
+typedef struct
+{
+	ow_sim_device_t* p_device;
+	int16_t          temperature;
+} sensor_model_t;
+
+static sensor_model_t m_models[SENSORS_MAX_COUNT];
+static uint16_t       m_models_count;
+
+static ds18b20_t      m_sensors[SENSORS_MAX_COUNT];
+static uint16_t       m_sensors_count;
+static uint16_t       m_sensor_index;
+static uint16_t       m_errors;
+static uint16_t       m_alarmed;
+
+static ow_packet_t    m_ow_packet;
+static ROM_code_t     m_ROM_code;
+static uint8_t        m_channel;
+
+static uint32_t       m_random = 1;
+
+static uint32_t random_next(void)
+{
+	m_random = m_random * 1664525 + 1013904223;
+	return m_random >> 8;
+}
+
+//----------------------------------------------------------------------------------------------
+
+static void phase_report(const char* p_name, uint64_t start_us)
+{
+	ow_sim_stats_t stats;
+	uint64_t       op_us = 0;
+
+	ow_sim_stats(&stats, true);
+	for (uint8_t op = 0; op < OW_SIM_OP_COUNT; ++op)
+		op_us += stats.op_time_us[op];
+	printf("%-16s %10.3f ms  %8.1f us op time/sensor  %8u resets  %9u slots\n", p_name,
+		(ow_sim_time_us() - start_us) / 1000.0, (double)op_us / m_sensors_count,
+		stats.op_count[OW_SIM_OP_RESET], stats.slots);
+}
+
+static sensor_model_t* model_find(const ROM_code_t* p_ROM_code)
+{
+	ROM_code_t ROM_code;
+
+	for (uint16_t k = 0; k < m_models_count; ++k)
+	{
+		ow_sim_device_rom(m_models[k].p_device, &ROM_code);
+		if (memcmp(&ROM_code, p_ROM_code, sizeof(ROM_code_t)) == 0)
+			return &m_models[k];
+	}
+	return NULL;
+}
+
+//----------------------------------------------------------------------------------------------
+// ROM search on every channel. Packet is repeated from callback until last device found.
+
+static uint32_t discovering_ow_callback(ow_result_t result, ow_packet_t* p_ow_packet)
+{
+	if (result == OWMR_SUCCESS)
+	{
+		if (m_sensors_count < SENSORS_MAX_COUNT)
+		{
+			ds18b20_t* p_sensor = &m_sensors[m_sensors_count++];
+
+			ds18b20_initialize(p_sensor, m_channel, DS18B20_RESOL, POWER_NORMAL);
+			ds18b20_set_ROM_code(p_sensor, p_ow_packet->p_ROM_code);
+			ds18b20_set_alarm_tempr(p_sensor, ALARM_LOW, ALARM_HIGH);
+			ds18b20_set_waiting_mode(p_sensor, OW_NOT_WAIT);
+		}
+		if (!p_ow_packet->search.last_device)
+			return 1;
+	}
+	else if (result != OWMR_NO_RESPONSE)
+	{
+		printf("channel %u: search error %u\n", m_channel, result);
+		++m_errors;
+	}
+	// next channel
+	if (++m_channel < OW_CHANNEL_COUNT)
+	{
+		p_ow_packet->channel = m_channel;
+		ow_search_first(p_ow_packet, false);
+	}
+	return 0;
+}
+
+static void discover(void)
+{
+	m_channel = 0;
+	m_ow_packet.callback   = discovering_ow_callback;
+	m_ow_packet.p_ROM_code = &m_ROM_code;
+	m_ow_packet.channel    = m_channel;
+	ow_search_first(&m_ow_packet, false);
+	ow_sim_run();
+}
+
+//----------------------------------------------------------------------------------------------
+// Configuration of every sensor (scratchpad writing and copying to EEPROM).
+
+static void configuring_ds18b20_callback(ds18b20_t* p_ds18b20)
+{
+	if (p_ds18b20->result != SUCCESS)
+	{
+		printf("sensor %u: configuring error %u\n", m_sensor_index, p_ds18b20->result);
+		++m_errors;
+	}
+	if (++m_sensor_index < m_sensors_count)
+		ds18b20_sincronize(&m_sensors[m_sensor_index], configuring_ds18b20_callback);
+}
+
+static void configure(void)
+{
+	m_sensor_index = 0;
+	if (m_sensors_count > 0)
+		ds18b20_sincronize(&m_sensors[0], configuring_ds18b20_callback);
+	ow_sim_run();
+}
+
+//----------------------------------------------------------------------------------------------
+// SKIP ROM + CONVERT T on every channel, ready flag of all sensors is waited.
+
+static uint32_t converting_ow_callback(ow_result_t result, ow_packet_t* p_ow_packet)
+{
+	if ((result != OWMR_SUCCESS) && (result != OWMR_NO_RESPONSE))
+	{
+		printf("channel %u: conversion error %u\n", m_channel, result);
+		++m_errors;
+	}
+	if (++m_channel < OW_CHANNEL_COUNT)
+		ds18b20_start_conversion_all(m_channel, converting_ow_callback, OW_WAIT_FLAG, DS18B20_RESOL);
+	return 0;
+}
+
+static void convert(void)
+{
+	m_channel = 0;
+	ds18b20_start_conversion_all(m_channel, converting_ow_callback, OW_WAIT_FLAG, DS18B20_RESOL);
+	ow_sim_run();
+}
+
+//----------------------------------------------------------------------------------------------
+// Scratchpad reading of every sensor, temperature is checked against model.
+
+static void reading_ds18b20_callback(ds18b20_t* p_ds18b20)
+{
+	sensor_model_t* p_model = model_find(&p_ds18b20->ROM_code);
+
+	if (p_ds18b20->result != SUCCESS)
+	{
+		printf("sensor %u: reading error %u\n", m_sensor_index, p_ds18b20->result);
+		++m_errors;
+	}
+	else if ((p_model == NULL) || (p_ds18b20->temperature != p_model->temperature))
+	{
+		printf("sensor %u: temperature %d, expected %d\n", m_sensor_index,
+			p_ds18b20->temperature, (p_model) ? p_model->temperature : 0);
+		++m_errors;
+	}
+	if (++m_sensor_index < m_sensors_count)
+		ds18b20_read_safe(&m_sensors[m_sensor_index], reading_ds18b20_callback);
+}
+
+static void read_all(void)
+{
+	m_sensor_index = 0;
+	if (m_sensors_count > 0)
+		ds18b20_read_safe(&m_sensors[0], reading_ds18b20_callback);
+	ow_sim_run();
+}
+
+#ifdef OW_DATA_SEGMENTS
+//----------------------------------------------------------------------------------------------
+// Scratchpad reading by data segments: temperature and rest of scratchpad are received into
+// separate buffers, CRC8 of scratchpad runs over both segments.
+
+static uint8_t        m_read_command = 0xBE;
+static int16_t        m_segment_temperature;
+static uint8_t        m_segment_rest[7];
+static ow_segment_t   m_segments[] =
+{
+	{ .p_buf = &m_read_command,                     .count = 8,  .rx = false },
+	{ .p_buf = (uint8_t*)&m_segment_temperature,    .count = 16, .rx = true  },
+	{ .p_buf = m_segment_rest,                      .count = 56, .rx = true  },
+};
+
+static void segment_read_next(ow_packet_t* p_ow_packet)
+{
+	ds18b20_t* p_sensor = &m_sensors[m_sensor_index];
+
+	p_ow_packet->ROM_command       = OWM_CMD_MATCH;
+	p_ow_packet->p_ROM_code        = &p_sensor->ROM_code;
+	p_ow_packet->channel           = p_sensor->channel;
+	memset(&p_ow_packet->data, 0, sizeof(p_ow_packet->data));
+	p_ow_packet->data.p_segments    = m_segments;
+	p_ow_packet->data.segment_count = sizeof(m_segments) / sizeof(m_segments[0]);
+#ifdef OW_RX_CRC8
+	p_ow_packet->data.rx_crc_check  = 9;
+#endif
+}
+
+static uint32_t segment_reading_ow_callback(ow_result_t result, ow_packet_t* p_ow_packet)
+{
+	sensor_model_t* p_model = model_find(&m_sensors[m_sensor_index].ROM_code);
+
+	if (result != OWMR_SUCCESS)
+	{
+		printf("sensor %u: segmented reading error %u\n", m_sensor_index, result);
+		++m_errors;
+	}
+#ifdef OW_RX_CRC8
+	else if (p_ow_packet->data.rx_crc8 != 0)
+	{
+		printf("sensor %u: segmented reading CRC8 %02x\n", m_sensor_index, p_ow_packet->data.rx_crc8);
+		++m_errors;
+	}
+#endif
+	else if ((p_model == NULL) || (m_segment_temperature != p_model->temperature))
+	{
+		printf("sensor %u: segmented temperature %d, expected %d\n", m_sensor_index,
+			m_segment_temperature, (p_model) ? p_model->temperature : 0);
+		++m_errors;
+	}
+	if (++m_sensor_index >= m_sensors_count)
+		return 0;
+	segment_read_next(p_ow_packet);
+	return 1;
+}
+
+static void segment_read_all(void)
+{
+	m_sensor_index = 0;
+	if (m_sensors_count == 0)
+		return;
+	m_ow_packet.callback = segment_reading_ow_callback;
+	segment_read_next(&m_ow_packet);
+	ow_enqueue_packet(&m_ow_packet);
+	ow_sim_run();
+}
+#endif
+
+//----------------------------------------------------------------------------------------------
+// Alarm search on every channel.
+
+static uint32_t alarm_ow_callback(ow_result_t result, ow_packet_t* p_ow_packet)
+{
+	if (result == OWMR_SUCCESS)
+	{
+		++m_alarmed;
+		if (!p_ow_packet->search.last_device)
+			return 1;
+	}
+	else if ((result != OWMR_NOT_FOUND) && (result != OWMR_NO_RESPONSE))
+	{
+		printf("channel %u: alarm search error %u\n", m_channel, result);
+		++m_errors;
+	}
+	if (++m_channel < OW_CHANNEL_COUNT)
+	{
+		p_ow_packet->channel = m_channel;
+		ow_search_first(p_ow_packet, true);
+	}
+	return 0;
+}
+
+static void alarm_search(void)
+{
+	m_channel = 0;
+	m_alarmed = 0;
+	m_ow_packet.callback = alarm_ow_callback;
+	m_ow_packet.channel  = m_channel;
+	ow_search_first(&m_ow_packet, true);
+	ow_sim_run();
+}
+
+//----------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+	uint16_t count = SENSORS_DEFAULT_COUNT;
+	uint16_t expected_alarmed = 0;
+	uint64_t start_us;
+
+	if (argc > 1)
+		count = (uint16_t)atoi(argv[1]);
+	if ((count == 0) || (count > SENSORS_MAX_COUNT))
+	{
+		printf("usage: %s [devices 1..%u]\n", argv[0], SENSORS_MAX_COUNT);
+		return 1;
+	}
+
+	ow_sim_reset();
+	for (uint16_t k = 0; k < count; ++k)
+	{
+		sensor_model_t* p_model = &m_models[m_models_count++];
+		uint64_t        serial  = ((uint64_t)random_next() << 24) ^ random_next();
+
+		// -10.0 .. +45.0 C
+		p_model->temperature = (int16_t)((random_next() % (55 * 16)) - 10 * 16);
+		p_model->p_device = ow_sim_ds18b20_add(k % OW_CHANNEL_COUNT, serial, 0);
+		ow_sim_ds18b20_temperature(p_model->p_device, p_model->temperature);
+		if (((p_model->temperature >> 4) >= ALARM_HIGH) || ((p_model->temperature >> 4) <= ALARM_LOW))
+			++expected_alarmed;
+	}
+	printf("%u DS18B20 on %u channels\n\n", count, OW_CHANNEL_COUNT);
+
+	ow_manager_initialize();
+
+	start_us = ow_sim_time_us();
+	discover();
+	phase_report("search", start_us);
+	if (m_sensors_count != count)
+	{
+		printf("found %u sensors, expected %u\n", m_sensors_count, count);
+		++m_errors;
+	}
+
+	start_us = ow_sim_time_us();
+	configure();
+	phase_report("configuration", start_us);
+
+	start_us = ow_sim_time_us();
+	convert();
+	phase_report("conversion", start_us);
+
+	start_us = ow_sim_time_us();
+	read_all();
+	phase_report("reading", start_us);
+
+#ifdef OW_DATA_SEGMENTS
+	start_us = ow_sim_time_us();
+	segment_read_all();
+	phase_report("segmented read", start_us);
+#endif
+
+	start_us = ow_sim_time_us();
+	alarm_search();
+	phase_report("alarm search", start_us);
+	if (m_alarmed != expected_alarmed)
+	{
+		printf("alarm search found %u sensors, expected %u\n", m_alarmed, expected_alarmed);
+		++m_errors;
+	}
+
+	printf("\n%u HAL operations, %.3f ms " HAL_TIME_LABEL ", %u errors\n",
+		owmh_isr_count(), owmh_active_time_us() / 1000.0, m_errors);
+	return (m_errors == 0) ? 0 : 1;
+}
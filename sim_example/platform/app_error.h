@@ -0,0 +1,23 @@
+#ifndef APP_ERROR_H__
+#define APP_ERROR_H__
+
+// Host stub of nRF5 SDK error handling. Failed check aborts simulation.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static inline void app_error_host(uint32_t error_code, const char* p_file, int line)
+{
+	fprintf(stderr, "%s:%d: error %u\n", p_file, line, (unsigned)error_code);
+	abort();
+}
+
+#define APP_ERROR_CHECK(err_code) \
+	do { uint32_t local_err_code = (err_code); \
+		if (local_err_code != 0) app_error_host(local_err_code, __FILE__, __LINE__); } while (0)
+
+#define APP_ERROR_CHECK_BOOL(boolean_value) \
+	do { if (!(boolean_value)) app_error_host(1, __FILE__, __LINE__); } while (0)
+
+#endif // APP_ERROR_H__
@@ -0,0 +1,10 @@
+#ifndef APP_UTIL_H__
+#define APP_UTIL_H__
+
+// Host stub of nRF5 SDK utilities used by 1-wire modules
+
+#define __INLINE                    inline
+#define UNUSED_PARAMETER(x)         ((void)(x))
+#define IS_POWER_OF_TWO(A)          (((A) != 0) && ((((A) - 1) & (A)) == 0))
+
+#endif // APP_UTIL_H__
@@ -0,0 +1,11 @@
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+
+// Host stub. Simulation is single threaded, critical regions are empty.
+
+#include "app_util.h"
+
+#define CRITICAL_REGION_ENTER()     {
+#define CRITICAL_REGION_EXIT()      }
+
+#endif // APP_UTIL_PLATFORM_H__
@@ -0,0 +1,10 @@
+#ifndef NRF_ASSERT_H_
+#define NRF_ASSERT_H_
+
+// Host stub of nRF5 SDK assert
+
+#include <assert.h>
+
+#define ASSERT(expr)                assert(expr)
+
+#endif // NRF_ASSERT_H_
@@ -0,0 +1,21 @@
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+
+// Host stub of nRF5 SDK logger. Driver logs are printed if OW_SIM_LOG is defined.
+// SDK headers include standard library headers used by drivers (string.h).
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef OW_SIM_LOG
+#define NRF_LOG_RAW_INFO(...)       printf(__VA_ARGS__)
+#else
+static inline void nrf_log_host_discard(const char* p_format, ...)
+{
+	(void)p_format;
+}
+#define NRF_LOG_RAW_INFO(...)       nrf_log_host_discard(__VA_ARGS__)
+#endif
+#define NRF_LOG_FLUSH()             ((void)0)
+
+#endif // NRF_LOG_H_
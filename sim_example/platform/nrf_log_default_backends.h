@@ -0,0 +1,6 @@
+#ifndef NRF_LOG_DEFAULT_BACKENDS_H__
+#define NRF_LOG_DEFAULT_BACKENDS_H__
+
+#include "nrf_log.h"
+
+#endif // NRF_LOG_DEFAULT_BACKENDS_H__
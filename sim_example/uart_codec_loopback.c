@@ -0,0 +1,250 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ow_uart_codec.h"
+
+// Loopback check of 1-wire over UART line coding (ow_uart_codec.h) used by UARTE HAL backend.
+// Line model: UART frame of master (start bit, 8 data bits LSB first, stop bit) and pull-down
+// of device are wired-AND on 1-wire line, receiver samples every data bit in its middle.
+// Device pulls line low relative to falling edge of slot: presence pulse after reset pulse,
+// read 0 after short strobe. Echoes are decoded as UARTE HAL does, sequences longer than
+// DMA buffer are transferred in parts.
+
+#define BAUD_RESET              9600
+#define BAUD_DATA               115200
+#define BAUD_DATA_OVERDRIVE     1000000
+
+#define UART_PART_MAX           255      // EasyDMA MAXCNT of UARTE
+
+#define RESET_MIN_NS            480000   // shortest reset pulse recognised by device
+#define PRESENCE_WAIT_NS        30000
+#define PRESENCE_PULSE_NS       120000
+#define READ_STROBE_MAX_NS      15000    // longer strobe is write 0 for device
+#define READ0_HOLD_NS           30000
+#define READ0_HOLD_OVERDRIVE_NS 3000
+
+#define SEQUENCE_TX_BITS        24
+#define SEQUENCE_RX_BITS        600
+#define SEQUENCE_COLLISION      400      // slot of write 1 pulled low by device
+
+static uint16_t m_errors;
+
+static void check(bool condition, const char* p_name)
+{
+	if (condition)
+		return;
+	printf("FAILED: %s\n", p_name);
+	++m_errors;
+}
+
+//----------------------------------------------------------------------------------------------
+// Line model
+
+static uint32_t bit_ns(uint32_t baud)
+{
+	return 1000000000UL / baud;
+}
+
+// Time of line release by master: start bit and following 0 data bits
+static uint32_t master_release_ns(uint8_t tx, uint32_t baud)
+{
+	uint8_t low_bits = 1;
+
+	while ((low_bits < 9) && (!(tx & (1 << (low_bits - 1)))))
+		++low_bits;
+	return low_bits * bit_ns(baud);
+}
+
+// Echo of UART byte, device holds line low from pull_from_ns to pull_to_ns of slot
+static uint8_t line_echo(uint8_t tx, uint32_t baud, uint32_t pull_from_ns, uint32_t pull_to_ns)
+{
+	uint32_t period_ns = bit_ns(baud);
+	uint8_t  echo = 0;
+
+	for (uint8_t k = 0; k < 8; ++k)
+	{
+		uint32_t sample_ns = period_ns + k * period_ns + period_ns / 2;
+		bool     pulled = ((sample_ns >= pull_from_ns) && (sample_ns < pull_to_ns));
+
+		if ((tx & (1 << k)) && (!pulled))
+			echo |= (uint8_t)(1 << k);
+	}
+	return echo;
+}
+
+static uint8_t reset_echo(uint8_t tx, uint32_t baud, bool present)
+{
+	uint32_t release_ns = master_release_ns(tx, baud);
+
+	if ((!present) || (release_ns < RESET_MIN_NS))
+		return line_echo(tx, baud, 0, 0);
+	return line_echo(tx, baud, release_ns + PRESENCE_WAIT_NS, release_ns + PRESENCE_WAIT_NS + PRESENCE_PULSE_NS);
+}
+
+// Data slot, device answers bit in read slot
+static uint8_t slot_echo(uint8_t tx, uint32_t baud, uint8_t device_bit)
+{
+	uint32_t hold_ns = (baud == BAUD_DATA_OVERDRIVE) ? READ0_HOLD_OVERDRIVE_NS : READ0_HOLD_NS;
+
+	if ((device_bit) || (master_release_ns(tx, baud) > READ_STROBE_MAX_NS))
+		return line_echo(tx, baud, 0, 0);
+	return line_echo(tx, baud, 0, hold_ns);
+}
+
+//----------------------------------------------------------------------------------------------
+// Reset slot: presence pulse corrupts high nibble of echo.
+
+static void check_reset(void)
+{
+	uint8_t echo;
+
+	echo = reset_echo(OW_UART_RESET, BAUD_RESET, false);
+	check(echo == OW_UART_RESET, "reset echo without device");
+	check(ow_uart_decode_reset(echo) == OWMHCR_RESET_NO_RESPONCE, "reset without device");
+
+	echo = reset_echo(OW_UART_RESET, BAUD_RESET, true);
+	check(((echo & 0x0F) == 0) && (echo != OW_UART_RESET), "presence in high nibble");
+	check(ow_uart_decode_reset(echo) == OWMHCR_RESET_OK, "reset with presence");
+
+	// line held low by short circuit
+	check(ow_uart_decode_reset(line_echo(OW_UART_RESET, BAUD_RESET, 0, UINT32_MAX)) == OWMHCR_ERROR,
+		"reset on shorted line");
+	// low nibble is driven by master, it is high only if reset pulse was shortened
+	check(ow_uart_decode_reset(0xF1) == OWMHCR_ERROR, "shortened reset pulse");
+	check(ow_uart_decode_reset(0xE8) == OWMHCR_ERROR, "shortened reset pulse with presence");
+}
+
+//----------------------------------------------------------------------------------------------
+// Single slots: read 0 stretches start bit, write slots echo transmitted byte.
+
+static void check_slots(void)
+{
+	uint8_t tx_byte = 0x02;    // write 0, write 1
+	uint8_t rx_byte = 0;
+	uint8_t uart_buf[4];
+	uint8_t echo;
+
+	check(slot_echo(OW_UART_BIT_1, BAUD_DATA, 1) == OW_UART_BIT_1, "read 1 echo");
+	echo = slot_echo(OW_UART_BIT_1, BAUD_DATA, 0);
+	check((echo != OW_UART_BIT_1) && (ow_uart_echo_valid(echo)), "read 0 stretches start bit");
+	echo = slot_echo(OW_UART_BIT_1, BAUD_DATA_OVERDRIVE, 0);
+	check((echo != OW_UART_BIT_1) && (ow_uart_echo_valid(echo)), "read 0 stretches start bit in overdrive");
+	check(slot_echo(OW_UART_BIT_0, BAUD_DATA, 1) == OW_UART_BIT_0, "write 0 echo");
+	check(slot_echo(OW_UART_BIT_0_OVERDRIVE, BAUD_DATA_OVERDRIVE, 1) == OW_UART_BIT_0_OVERDRIVE,
+		"write 0 echo in overdrive");
+
+	// 2 write slots, 2 read slots (0, 1)
+	ow_uart_encode(uart_buf, &tx_byte, 2, 0, 4, OW_UART_BIT_0);
+	check((uart_buf[0] == OW_UART_BIT_0) && (uart_buf[1] == OW_UART_BIT_1) &&
+		(uart_buf[2] == OW_UART_BIT_1) && (uart_buf[3] == OW_UART_BIT_1), "encoding of slots");
+	uart_buf[0] = slot_echo(uart_buf[0], BAUD_DATA, 1);
+	uart_buf[1] = slot_echo(uart_buf[1], BAUD_DATA, 1);
+	uart_buf[2] = slot_echo(uart_buf[2], BAUD_DATA, 0);
+	uart_buf[3] = slot_echo(uart_buf[3], BAUD_DATA, 1);
+	rx_byte = 0x01;
+	check(ow_uart_decode(uart_buf, &tx_byte, &rx_byte, 2, 0, 4) && (rx_byte == 0x02), "decoding of slots");
+
+	ow_uart_encode(uart_buf, &tx_byte, 2, 0, 1, OW_UART_BIT_0_OVERDRIVE);
+	check(uart_buf[0] == OW_UART_BIT_0_OVERDRIVE, "encoding of write 0 in overdrive");
+}
+
+//----------------------------------------------------------------------------------------------
+// Invalid echoes: noise on line and write slots disturbed by device.
+
+static void check_invalid(void)
+{
+	static const uint8_t noise[] = { 0xEF, 0xFD, 0xF9, 0x7F, 0x01, 0xAA };
+	uint8_t tx_byte = 0x01;    // write 1
+	uint8_t rx_byte = 0;
+	uint8_t echo;
+
+	for (uint8_t k = 0; k < sizeof(noise); ++k)
+	{
+		check(!ow_uart_echo_valid(noise[k]), "noise echo");
+		check(!ow_uart_decode(&noise[k], &tx_byte, &rx_byte, 0, 0, 1), "noise in read slot");
+	}
+	check(ow_uart_echo_valid(0xFE) && ow_uart_echo_valid(0xF8) && ow_uart_echo_valid(0x00) &&
+		ow_uart_echo_valid(OW_UART_BIT_1), "valid echoes");
+
+	// write 1 answered as read 0 by device
+	echo = slot_echo(OW_UART_BIT_1, BAUD_DATA, 0);
+	check(!ow_uart_decode(&echo, &tx_byte, &rx_byte, 1, 0, 1), "collision in write 1 slot");
+	// line high while master holds it low
+	echo = 0x10;
+	tx_byte = 0;
+	check(!ow_uart_decode(&echo, &tx_byte, &rx_byte, 1, 0, 1), "noise in write 0 slot");
+}
+
+//----------------------------------------------------------------------------------------------
+// Sequence longer than DMA buffer, transferred in parts as by UARTE HAL.
+
+static uint8_t device_bit(const uint8_t* p_data, uint16_t index)
+{
+	return (p_data[index >> 3] >> (index & 0x07)) & 1;
+}
+
+// False, if any part fails. collision - write 1 slot answered as read 0, or UINT16_MAX.
+static bool sequence_transfer(const uint8_t* p_txdata, uint8_t* p_rxdata, const uint8_t* p_device,
+                              uint16_t tx_count, uint16_t rx_count, uint16_t collision)
+{
+	uint8_t  uart_buf[UART_PART_MAX];
+	uint16_t slot_count = tx_count + rx_count;
+
+	for (uint16_t first = 0; first < slot_count; first += UART_PART_MAX)
+	{
+		uint16_t count = ((slot_count - first) > UART_PART_MAX) ? UART_PART_MAX : (slot_count - first);
+
+		ow_uart_encode(uart_buf, p_txdata, tx_count, first, count, OW_UART_BIT_0);
+		for (uint16_t k = 0; k < count; ++k)
+		{
+			uint16_t slot = first + k;
+			uint8_t  bit = (slot < tx_count) ? (slot != collision) : device_bit(p_device, slot - tx_count);
+
+			uart_buf[k] = slot_echo(uart_buf[k], BAUD_DATA, bit);
+		}
+		if (!ow_uart_decode(uart_buf, p_txdata, p_rxdata, tx_count, first, count))
+			return false;
+	}
+	return true;
+}
+
+static void check_sequence(void)
+{
+	uint8_t  txdata[(SEQUENCE_RX_BITS + 7) / 8];
+	uint8_t  rxdata[(SEQUENCE_RX_BITS + 7) / 8];
+	uint8_t  device[(SEQUENCE_RX_BITS + 7) / 8];
+	uint32_t random = 1;
+
+	for (uint16_t k = 0; k < sizeof(device); ++k)
+	{
+		random = random * 1664525 + 1013904223;
+		device[k] = (uint8_t)(random >> 24);
+		txdata[k] = (uint8_t)(random >> 16);
+	}
+
+	memset(rxdata, 0xA5, sizeof(rxdata));
+	check(sequence_transfer(txdata, rxdata, device, SEQUENCE_TX_BITS, SEQUENCE_RX_BITS, UINT16_MAX) &&
+		(memcmp(rxdata, device, sizeof(device)) == 0), "read sequence in parts");
+
+	check(sequence_transfer(txdata, rxdata, device, SEQUENCE_RX_BITS, 0, UINT16_MAX),
+		"write sequence in parts");
+	// collision in slot of middle part
+	txdata[SEQUENCE_COLLISION >> 3] |= (uint8_t)(1 << (SEQUENCE_COLLISION & 0x07));
+	check(!sequence_transfer(txdata, rxdata, device, SEQUENCE_RX_BITS, 0, SEQUENCE_COLLISION),
+		"collision in middle part of write sequence");
+}
+
+//----------------------------------------------------------------------------------------------
+
+int main(void)
+{
+	check_reset();
+	check_slots();
+	check_invalid();
+	check_sequence();
+
+	printf("1-wire UART codec loopback: %u errors\n", m_errors);
+	return (m_errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// platform dependent
+#include "app_error.h"
+#include "app_timer.h"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+#include "nrf_log_default_backends.h"
+#define  CHECK_ERROR( int_expresion ) APP_ERROR_CHECK( int_expresion )
+#define  CHECK_ERROR_BOOL( bool_expresion ) APP_ERROR_CHECK_BOOL( bool_expresion )
+#define  HANDLE_ERROR() APP_ERROR_CHECK_BOOL( false )
+#define  LOG_PRINTF NRF_LOG_RAW_INFO
+// end of platform dependent section
+
+#include "ow_manager.h"
+#include "ow_bus_group.h"
+
+#if ((defined (OW_MULTI_CHANNEL)) && (defined (OW_BUS_BENCHMARK)))
+
+//----------------------------------------------------------------------------------------------
+// Throughput of bus groups. Every channel repeats READ ROM packet (reset, 8 bit command,
+// 64 bit address) during BENCHMARK_TIME. Channels of one group are time-multiplexed, channels
+// of different groups transfer concurrently, so aggregate bit rate scales with number of groups.
+// Build with OW_BUS_GROUP_COUNT 1, 2, 3 with the same channels to compare.
+// Callback requeues packet at once, so manager may keep serving one channel of a group:
+// bit rate of every channel is reported to show the share of channels within group.
+
+#define BENCHMARK_TIME      10000
+#define BENCHMARK_BITS      72
+
+APP_TIMER_DEF(benchmark_timer);
+
+static ow_packet_t  m_ow_packets[OW_CHANNEL_COUNT];
+static ROM_code_t   m_ROMcodes[OW_CHANNEL_COUNT];
+static uint32_t     m_packets_counter[OW_CHANNEL_COUNT];
+static uint32_t     m_errors_counter[OW_CHANNEL_COUNT];
+static uint8_t      m_channels_active;
+static bool         m_benchmark_stop;
+
+static void benchmark_report()
+{
+	uint32_t group_bits[OW_BUS_GROUP_COUNT];
+	uint32_t total_bits = 0;
+
+	memset(group_bits, 0, sizeof(group_bits));
+	for (uint8_t channel = 0; channel < OW_CHANNEL_COUNT; ++channel)
+	{
+		uint32_t bits = (m_packets_counter[channel] - m_errors_counter[channel]) * BENCHMARK_BITS;
+		LOG_PRINTF("\nChannel %d (group %d): %d packets, %d errors, %d bit/s", channel, OW_GROUP_OF(channel),
+			m_packets_counter[channel], m_errors_counter[channel], bits / (BENCHMARK_TIME / 1000));
+		group_bits[OW_GROUP_OF(channel)] += bits;
+		total_bits += bits;
+	}
+	for (uint8_t group = 0; group < OW_BUS_GROUP_COUNT; ++group)
+		LOG_PRINTF("\nGroup %d: %d bit/s", group, group_bits[group] / (BENCHMARK_TIME / 1000));
+	LOG_PRINTF("\n>>> Groups: %d, aggregate throughput: %d bit/s", OW_BUS_GROUP_COUNT, total_bits / (BENCHMARK_TIME / 1000));
+}
+
+static uint32_t benchmark_ow_callback(ow_result_t result, ow_packet_t* p_ow_packet)
+{
+	uint8_t channel = p_ow_packet->channel;
+
+	m_packets_counter[channel]++;
+	if (result != OWMR_SUCCESS)
+		m_errors_counter[channel]++;
+
+	if (!m_benchmark_stop)
+		return 1;
+
+	if (--m_channels_active == 0)
+		benchmark_report();
+	return 0;
+}
+
+static void benchmark_timer_on_time_out_callback(void * p_context)
+{
+	m_benchmark_stop = true;
+}
+
+void start_ow_test()
+{
+	// Initialize 1-wire driver.
+	ow_manager_initialize();
+
+	CHECK_ERROR(app_timer_create(&benchmark_timer, APP_TIMER_MODE_SINGLE_SHOT, benchmark_timer_on_time_out_callback));
+
+	LOG_PRINTF("\n>>> Bus groups benchmark started.");
+	m_benchmark_stop = false;
+	m_channels_active = OW_CHANNEL_COUNT;
+	for (uint8_t channel = 0; channel < OW_CHANNEL_COUNT; ++channel)
+	{
+		ow_packet_t* p_ow_packet = &m_ow_packets[channel];
+		memset(p_ow_packet, 0, sizeof(ow_packet_t));
+		p_ow_packet->callback = benchmark_ow_callback;
+		p_ow_packet->p_ROM_code = &m_ROMcodes[channel];
+		p_ow_packet->ROM_command = OWM_CMD_READ;
+		p_ow_packet->channel = channel;
+		ow_enqueue_packet(p_ow_packet);
+	}
+	CHECK_ERROR(app_timer_start(benchmark_timer, APP_TIMER_TICKS(BENCHMARK_TIME), NULL));
+}
+
+#endif
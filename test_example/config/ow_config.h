@@ -8,6 +8,97 @@
 // nRFF52 1-wire master HAL timer instance  
 #define OW_TIMER_INSTANCE 2
 
+// if defined, timeslots of sequence are chained by hardware (TIMER shorts, PPI and
+// counter timer), interrupt is invoked once per batch (up to 4 read or 3 write timeslots)
+// instead of every timeslot. Interrupt load can be compared by OW_HAL_ISR_COUNTER.
+// OW_TIMER_INSTANCE must be 3 or 4 (TIMER with 6 CC registers) in this case.
+//#define OW_SLOT_ENGINE
+
+// nRFF52 timer instance used as timeslot counter by OW_SLOT_ENGINE
+#define OW_COUNTER_TIMER_INSTANCE 1
+
+// if defined, UARTE HAL backend used instead of TIMER/PPI backend.
+// Every 1-wire bit transferred as one UART byte by EasyDMA, so whole
+// sequence costs one interrupt. Delays are timed by app_timer.
+// UART driver of OW_UARTE_INSTANCE must be disabled in sdk_config.h.
+//#define OW_HAL_UARTE
+
+// nRFF52 1-wire master HAL UARTE instance
+#define OW_UARTE_INSTANCE 0
+
+// if defined, DS2482-100/-800 I2C bridge HAL backend used instead of TIMER/PPI backend.
+// Timeslots are generated by bridge, whole bytes and search steps are transferred by
+// byte and triplet commands over TWIM. Parasite power requires OW_HW_STRONG_PULLUP.
+//#define OW_HAL_DS2482
+
+// if defined, bridge is DS2482-800, channels are selected by its channel select register
+//#define OW_DS2482_800
+
+// nRFF52 TWIM instance and pins of DS2482 bridge (nrfx TWIM driver and
+// the instance must be enabled in sdk_config.h)
+#define OW_TWI_INSTANCE 0
+#define OW_TWI_SCL_PIN 27
+#define OW_TWI_SDA_PIN 26
+
+// I2C clock of DS2482 bridge, kHz (100, 250 or 400)
+//#define OW_TWI_FREQUENCY_KHZ 400
+
+// 7 bit I2C address of DS2482 bridge
+//#define OW_DS2482_ADDRESS 0x18
+
+// if defined, HAL counts serviced interrupts and active time of HFCLK
+// peripherals (owmh_isr_count(), owmh_active_time_us()). Single channel example logs
+// them per conversion packet.
+//#define OW_HAL_ISR_COUNTER
+
+// if defined, preemption of timeslot strobe (SoftDevice) is detected by cycle counter
+// (TIMER backend). Late reset and flag reading slots are re-issued, packet with other
+// late slot is restarted by master up to OW_SLOT_RETRY times (owmh_retry_count())
+//#define OW_SLOT_RETRY 2
+
+// if defined, reset slot is finished given recovery time (us) after end of presence pulse
+// instead of full reset delay (TIMER backend). GPIOTE interrupt of in pin detects the end,
+// its priority should not be lower than priority of 1-wire timer
+//#define OW_RESET_EARLY_EXIT 15
+
+// if defined, read and write slots are finished given recovery time (us) after captured
+// release edge, but not before minimal timeslot (TIMER backend, slot by slot processing)
+//#define OW_SLOT_EARLY_END 5
+
+// if defined, failed operations are classified (shorted line, line not released after slot,
+// presence out of window, edge timing, late interrupt) and counted per channel
+// (ow_channel_fault_stats())
+//#define OW_BUS_FAULTS
+
+// if defined, channel with given number of operations in a row started on shorted line is
+// quarantined: its packets fail without bus activity, line is probed with back-off (ow_bus_fault.h)
+//#define OW_FAULT_QUARANTINE 4
+
+// if defined, HAL maintains CRC8 of received bytes in interrupts (packet data.rx_crc8).
+// Reading is aborted, as soon as CRC8 of first data.rx_crc_check bytes fails
+//#define OW_RX_CRC8
+
+// if defined, HAL accepts next sequence while current operation is in progress and starts
+// it from completion interrupt. Master stages ROM command, ROM address and data phases
+//#define OW_HAL_STAGING
+
+// if defined, packet data can be given as list of transmitted and reseived segments
+// (data.p_segments), every segment with own buffer and bit count
+//#define OW_DATA_SEGMENTS
+
+// if defined, presence pulse of device attached to channel out of transfer is reported
+// to handler (ow_channel_hot_plug_arm()). Multi channel TIMER backend requires
+// OW_CHANNEL_PREALLOCATED, in pins of all channels are GPIOTE channels then
+//#define OW_HOT_PLUG
+
+// if defined, TIMER HAL accumulates per channel histograms of captured slot edges
+// and counts read edges close to read bounds (ow_channel_slot_stats())
+//#define OW_SLOT_HISTOGRAM
+
+// if defined, TIMER HAL records primitives, timeslots and results into ring buffer
+// of OW_TRACE records (power of 2, 8 bytes per record), see ow_trace.h
+//#define OW_TRACE 256
+
 // 1-wire manager packet queue capacity
 #define OW_MANAGER_FIFO_SIZE 16
 
@@ -17,6 +108,32 @@
 // if not defined, driver functions for parasite power support excluded
 #define OW_PARASITE_POWER_SUPPORT
 
+// if defined, delays and hold power phases of TIMER HAL backend are timed by
+// RTC based app_timer (app_timer_init() must be called by application)
+//#define OW_LOW_POWER_DELAY
+
+// if defined, ready flag is polled densely only around expected completion time
+// (percentage of wait flag time-out), HAL sleeps before and backs off after.
+// Parameters are in ow_flag_poll.h and can be overridden here.
+//#define OW_PREDICTIVE_FLAG_POLL
+//#define OW_FLAG_EXPECTED_PERCENT    80
+//#define OW_FLAG_DENSE_WINDOW_US     8000
+//#define OW_FLAG_POLL_MIN_US         250
+//#define OW_FLAG_POLL_MAX_US         8000
+
+// if defined, overdrive speed supported (OVERDRIVE SKIP / MATCH ROM commands)
+//#define OW_OVERDRIVE_SUPPORT
+
+// if defined, slot timing of channel can be calibrated by edges captured
+// in transfers (ow_channel_calibrate()). TIMER HAL backend only.
+//#define OW_BUS_CALIBRATION
+// if defined, calibration is repeated automatically every 1024 timeslots
+//#define OW_BUS_CALIBRATION_BACKGROUND
+
+// if defined, strong pull-up is engaged by hardware (PPI/GPIOTE) right after
+// last bit of command preceding hold power
+//#define OW_HW_STRONG_PULLUP
+
 // if defined, separated pin used for power forcing
 // else out pin configuration changes temporarily
 //#define OW_DEDICATED_POWER_PIN 
@@ -36,6 +153,29 @@
 // example for 2 channels without dedicated power pin
 // { { IN0,  OUT0 }, { IN1,  OUT1 } }        
 #define OW_PINS_ARRAY  { { 2,  3 },{ 4,  5 }  }
+// if defined, GPIOTE and PPI of all channels are set up at initialization, switching
+// of channel is just switching of PPI groups (TIMER backend). Every channel takes
+// 2 GPIOTE channels and PPI group, so up to 4 channels
+//#define OW_CHANNEL_PREALLOCATED
+// if defined, packet with channel_mask is transferred on all channels of mask at once
+// by one timer (TIMER backend, OW_CHANNEL_PREALLOCATED). Reset and writing packets only,
+// up to 2 channels with TIMER0..2, up to 4 with TIMER3, TIMER4
+//#define OW_BROADCAST
+// number of bus groups (TIMER backend). Every group of channels has own TIMER, PPI and
+// master state, so groups transfer concurrently. Group N owns channels from
+// OW_GROUPN_FIRST_CHANNEL to first channel of next group. TIMER of group must be enabled
+// in sdk_config.h (NRFX_TIMERn_ENABLED)
+//#define OW_BUS_GROUP_COUNT 2
+#define OW_GROUP1_FIRST_CHANNEL          1
+#define OW_GROUP1_TIMER_INSTANCE         3
+//#define OW_GROUP1_COUNTER_TIMER_INSTANCE 2   // OW_SLOT_ENGINE only
+//#define OW_GROUP2_FIRST_CHANNEL          2
+//#define OW_GROUP2_TIMER_INSTANCE         4
+// if defined, test example runs bus groups throughput benchmark instead of sensors scanning
+//#define OW_BUS_BENCHMARK
+// initial timing profiles of channels (OWMH_PROFILE_STANDARD for all, if not defined).
+// Can be changed at runtime by ow_channel_profile_set()
+//#define OW_CHANNEL_PROFILES  { OWMH_PROFILE_FAST, OWMH_PROFILE_LONG_LINE }
 #else
 // 1-wire pins config
 #define OW_OUT_PIN  2
@@ -5898,8 +5898,9 @@
 
 // <e> UART0_ENABLED - Enable UART0 instance
 //==========================================================
+// disabled: UARTE0 is used by 1-wire UARTE HAL backend (OW_HAL_UARTE)
 #ifndef UART0_ENABLED
-#define UART0_ENABLED 1
+#define UART0_ENABLED 0
 #endif
 // <q> UART0_CONFIG_USE_EASY_DMA  - Default setting for using EasyDMA
  
@@ -14,6 +14,13 @@
 
 #include "ds18b20.h"
 
+// scratchpad (8 bytes and CRC8) validity
+#ifdef OW_RX_CRC8
+#define SCRATCHPAD_CRC_VALID(p_self)	((p_self)->ow_packet.data.rx_crc8 == 0)
+#else
+#define SCRATCHPAD_CRC_VALID(p_self)	checkcrc8((p_self)->databuffer[9], (p_self)->databuffer + 1, 8)
+#endif
+
 static uint32_t on_ow_transfer_completed(ow_result_t  result, ow_packet_t* p_ow_packet); 
 static void prepare_ow_packet(ds18b20_t* p_self, ds18b20_command_t command);
 static void send_command(ds18b20_t* p_self, ds18b20_command_t command, ds18b20_callback_t callback);
@@ -146,14 +153,8 @@ void ds18b20_start_conversion(ds18b20_t* p_self, ds18b20_callback_t callback)
 	send_command(p_self, CMD_TEMP_CONVERT, callback);
 }
 
-#ifdef OW_MULTI_CHANNEL
-void ds18b20_start_conversion_all(uint8_t channel, ow_packet_callback_t callback, 
+static void start_conversion_packet(ow_packet_callback_t callback, 
 								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution) {
-	m_ow_packet.channel = channel;
-#else 
-void ds18b20_start_conversion_all(ow_packet_callback_t callback, 
-								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution) {
-#endif
 	m_ow_packet.callback = callback;
 	m_ow_packet.delay_ms  = 0;
 	m_ow_packet.wait_flag = false;
@@ -181,6 +182,36 @@ void ds18b20_start_conversion_all(ow_packet_callback_t callback,
 	ow_enqueue_packet(&m_ow_packet);
 }
 
+#ifdef OW_MULTI_CHANNEL
+void ds18b20_start_conversion_all(uint8_t channel, ow_packet_callback_t callback, 
+								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution) {
+	m_ow_packet.channel = channel;
+#ifdef OW_BROADCAST
+	m_ow_packet.channel_mask = 0;
+#endif
+	start_conversion_packet(callback, waiting_mode, resolution);
+}
+#else 
+void ds18b20_start_conversion_all(ow_packet_callback_t callback, 
+								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution) {
+	start_conversion_packet(callback, waiting_mode, resolution);
+}
+#endif
+
+#ifdef OW_BROADCAST
+void ds18b20_start_conversion_broadcast(uint8_t channel_mask, ow_packet_callback_t callback, 
+								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution) {
+	uint8_t channel = 0;
+	CHECK_ERROR_BOOL((channel_mask != 0) && (channel_mask < (1 << OW_CHANNEL_COUNT)));
+	// lowest channel of mask selects bus group and timing profile
+	while ((channel < OW_CHANNEL_COUNT) && (!(channel_mask & (1 << channel))))
+		++channel;
+	m_ow_packet.channel = channel;
+	m_ow_packet.channel_mask = channel_mask;
+	start_conversion_packet(callback, waiting_mode, resolution);
+}
+#endif
+
 void ds18b20_read_fast(ds18b20_t* p_self, ds18b20_callback_t callback)
 {
 	p_self->convert_after_read = false;
@@ -238,6 +269,9 @@ static void prepare_ow_packet(ds18b20_t* p_self, ds18b20_command_t command)
 #endif
 	p_self->ow_packet.wait_flag = ((p_self->waiting_mode == OW_WAIT_FLAG)||(p_self->read_after_convert));
 	p_self->ow_packet.delay_ms  = 0;
+#ifdef OW_RX_CRC8
+	p_data->rx_crc_check = 0;
+#endif
 	
 	switch (command)
 	{
@@ -257,6 +291,10 @@ static void prepare_ow_packet(ds18b20_t* p_self, ds18b20_command_t command)
 		p_data->tx_count = 8;
 		p_data->p_rxbuf = p_buf + 1;
 		p_data->rx_count = 72;
+#ifdef OW_RX_CRC8
+		// scratchpad CRC8 is checked by HAL
+		p_data->rx_crc_check = 9;
+#endif
 		break;
 		
 	case CMD_TEMP_CONVERT:
@@ -356,7 +394,7 @@ static uint32_t on_ow_transfer_completed(ow_result_t  result, ow_packet_t* p_ow_
 			LOG_PRINTF("\n         - Scratchpad readed "); 
 			log_hex(p_self->databuffer + 1, 8);
 			
-			if (!checkcrc8(p_self->databuffer[9], p_self->databuffer + 1, 8))
+			if (!SCRATCHPAD_CRC_VALID(p_self))
 			{
 				LOG_PRINTF("\n         - ERROR! Crc8 check faled!"); 
 				op_result = COMMUNICATION_ERROR;
@@ -410,7 +448,7 @@ static uint32_t on_ow_transfer_completed(ow_result_t  result, ow_packet_t* p_ow_
 			break;
 			
 		case CMD_TEMP_READ_SAFE:
-			if (!checkcrc8(p_self->databuffer[9], p_self->databuffer + 1, 8))
+			if (!SCRATCHPAD_CRC_VALID(p_self))
 			{
 				op_result = COMMUNICATION_ERROR;
 				break;
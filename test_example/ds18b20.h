@@ -142,6 +142,13 @@ void ds18b20_start_conversion_all(uint8_t channel, ow_packet_callback_t callback
 void ds18b20_start_conversion_all(ow_packet_callback_t callback, 
 								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution);
 #endif
+
+#ifdef OW_BROADCAST
+// SKIP ROM + CONVERT T on all channels of mask by one packet (no OW_WAIT_FLAG mode).
+// Channels with sensors present are left in channel_mask of packet in callback
+void ds18b20_start_conversion_broadcast(uint8_t channel_mask, ow_packet_callback_t callback, 
+								ds18b20_waiting_t waiting_mode, ds18b20_resolution_t resolution);
+#endif
 	
 void ds18b20_read_fast(ds18b20_t* p_self, ds18b20_callback_t callback);
 void ds18b20_read_safe(ds18b20_t* p_self, ds18b20_callback_t callback);
@@ -18,7 +18,7 @@
 #include "ow_search_helpers.h"
 #include "ds18b20.h"
 
-#ifdef OW_MULTI_CHANNEL
+#if ((defined (OW_MULTI_CHANNEL)) && (!defined (OW_BUS_BENCHMARK)))
 
 //----------------------------------------------------------------------------------------------
 
@@ -17,6 +17,9 @@
 #include "ow_manager.h"
 #include "ow_search_helpers.h"
 #include "ds18b20.h"
+#ifdef OW_HAL_ISR_COUNTER
+#include "ow_master_hal.h"
+#endif
 
 #ifndef OW_MULTI_CHANNEL
 
@@ -53,6 +56,28 @@ static ROM_code_t   m_ROMcode;
 static ROM_code_t   m_ROMcode_test;
 static uint8_t      m_scans_counter = 0;
 
+#ifdef OW_HAL_ISR_COUNTER
+// HAL interrupts and HFCLK active time per conversion packet, for comparison of
+// conversion delays (OW_LOW_POWER_DELAY) on board.
+static uint32_t     m_isr_count_start;
+static uint32_t     m_active_us_start;
+
+static void conversion_counters_start(void)
+{
+	m_isr_count_start = owmh_isr_count();
+	m_active_us_start = owmh_active_time_us();
+}
+
+static void conversion_counters_log(void)
+{
+	LOG_PRINTF(" %d ISRs, %d us active.", owmh_isr_count() - m_isr_count_start,
+		owmh_active_time_us() - m_active_us_start);
+}
+#else
+#define conversion_counters_start()
+#define conversion_counters_log()
+#endif
+
 //----------------------------------------------------------------------------------------------
 
 #define ENCODE_TEMPR(msb, lsb) (msb * 16 + lsb * 16 / 100)
@@ -220,6 +245,7 @@ static void start_convertion_ds18b20_callback(ds18b20_t* p_ds18b20)
 	{ 
 		LOG_PRINTF(" ERROR detected!"); 
 	}
+	conversion_counters_log();
 
 	if (m_conversion_finished)
 	{
@@ -245,6 +271,7 @@ uint32_t start_convertion_ow_callback(ow_result_t result, ow_packet_t* p_ow_pack
 	{ 
 		LOG_PRINTF(" Conversion completed."); 
 	}
+	conversion_counters_log();
 
 	if (m_conversion_finished)
 	{
@@ -262,6 +289,7 @@ static void start_convertion_next()
 	if (m_single_family&&(m_sensors_count > 1))
 	{
 		// No devices of other types on bus. Group command can be done
+		conversion_counters_start();
 		ds18b20_start_conversion_all(
 			start_convertion_ow_callback,
 #ifdef OW_PARASITE_POWER_SUPPORT
@@ -285,6 +313,7 @@ static void start_convertion_next()
 	else
 	{
 		// Start temperature conversion in certain sensor.
+		conversion_counters_start();
 		ds18b20_start_conversion(&m_sensors[m_sensor_index], start_convertion_ds18b20_callback);
 		LOG_PRINTF("\n         - "); log_hex(&m_sensors[m_sensor_index].ROM_code.serial, 6);
 		LOG_PRINTF(": conversion started. ");
@@ -0,0 +1,227 @@
+// Converter of 1-wire bus trace (ow_trace.h) to VCD, for PulseView (sigrok) or GTKWave.
+//
+// Input is raw dump of ow_trace ring buffer from RAM of device, e.g.
+//   gdb:      dump binary value trace.bin ow_trace
+//   nrfjprog: nrfjprog --memrd <address of ow_trace> --n <size> (converted to binary)
+//
+// Build and run on host:
+//   gcc -O2 -o ow_trace_vcd tools/ow_trace_vcd.c
+//   ./ow_trace_vcd [-o offset] trace.bin > trace.vcd
+//
+// Every channel is drawn as 1-wire line dq<channel> (slot strobe and captured rising edge),
+// err<channel> pulses on failed primitives. Primitives and results are written as VCD comments.
+// 1-Wire decoder of PulseView can be attached to dq lines directly.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../ow_trace.h"
+
+#define MAX_CHANNELS    26
+#define ERR_PULSE_NS    1000
+
+typedef struct
+{
+	uint64_t    time_ns;
+	uint32_t    order;      // order of adding, changes at the same time keep it
+	uint8_t     channel;
+	char        signal;     // 'd' - dq line, 'e' - err line, 0 - comment
+	uint8_t     value;
+	const char* p_text;
+} change_t;
+
+static const char* op_names[] =
+{
+	"reset", "write", "read", "triplet", "sequence", "wait flag", "delay", "hold power"
+};
+
+static change_t* m_changes;
+static uint32_t  m_change_count;
+static uint32_t  m_change_capacity;
+
+static change_t* change_add(uint64_t time_ns, uint8_t channel, char signal, uint8_t value)
+{
+	change_t* p_change;
+
+	if (m_change_count == m_change_capacity)
+	{
+		m_change_capacity = (m_change_capacity) ? (2 * m_change_capacity) : 1024;
+		m_changes = realloc(m_changes, m_change_capacity * sizeof(change_t));
+		if (m_changes == NULL)
+		{
+			fprintf(stderr, "out of memory\n");
+			exit(1);
+		}
+	}
+	p_change = &m_changes[m_change_count];
+	p_change->time_ns = time_ns;
+	p_change->order   = m_change_count++;
+	p_change->channel = channel;
+	p_change->signal  = signal;
+	p_change->value   = value;
+	p_change->p_text  = NULL;
+	return p_change;
+}
+
+static int change_compare(const void* p_a, const void* p_b)
+{
+	const change_t* a = p_a;
+	const change_t* b = p_b;
+
+	if (a->time_ns != b->time_ns)
+		return (a->time_ns < b->time_ns) ? -1 : 1;
+	return (a->order < b->order) ? -1 : 1;
+}
+
+static uint8_t* load_file(const char* name, size_t* p_size)
+{
+	FILE*    file = fopen(name, "rb");
+	uint8_t* p_data;
+	long     size;
+
+	if (file == NULL)
+		return NULL;
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	p_data = malloc((size > 0) ? (size_t)size : 1);
+	if ((p_data == NULL) || (fread(p_data, 1, (size_t)size, file) != (size_t)size))
+	{
+		fclose(file);
+		free(p_data);
+		return NULL;
+	}
+	fclose(file);
+	*p_size = (size_t)size;
+	return p_data;
+}
+
+static char signal_id(const change_t* p_change)
+{
+	return (char)(((p_change->signal == 'd') ? 'a' : 'A') + p_change->channel);
+}
+
+int main(int argc, char** argv)
+{
+	const char*        name = NULL;
+	size_t             offset = 0;
+	size_t             size;
+	uint8_t*           p_data;
+	ow_trace_header_t  header;
+	ow_trace_record_t* p_records;
+	uint32_t           first;
+	uint32_t           last_time = 0;
+	uint64_t           cycles = 0;
+	uint64_t           last_ns = 0;
+	uint8_t            channels = 1;
+	char               text[64];
+
+	for (int k = 1; k < argc; ++k)
+	{
+		if ((strcmp(argv[k], "-o") == 0) && ((k + 1) < argc))
+			offset = strtoul(argv[++k], NULL, 0);
+		else
+			name = argv[k];
+	}
+	if (name == NULL)
+	{
+		fprintf(stderr, "usage: %s [-o offset] trace.bin > trace.vcd\n", argv[0]);
+		return 1;
+	}
+	p_data = load_file(name, &size);
+	if ((p_data == NULL) || ((offset + sizeof(header)) > size))
+	{
+		fprintf(stderr, "%s: can not read trace\n", name);
+		return 1;
+	}
+	memcpy(&header, p_data + offset, sizeof(header));
+	if ((header.magic != OW_TRACE_MAGIC) || (header.size == 0) || ((header.size & (header.size - 1)) != 0)
+			|| ((offset + sizeof(header) + (size_t)header.size * sizeof(ow_trace_record_t)) > size))
+	{
+		fprintf(stderr, "%s: no trace at offset %zu\n", name, offset);
+		return 1;
+	}
+	p_records = (ow_trace_record_t*)(p_data + offset + sizeof(header));
+	first = (header.head > header.size) ? (header.head - header.size) : 0;
+
+	// records to signal changes
+	for (uint32_t position = first; position != header.head; ++position)
+	{
+		const ow_trace_record_t* p_record = &p_records[position & (header.size - 1)];
+		uint64_t time_ns;
+
+		if (p_record->channel >= MAX_CHANNELS)
+			continue;
+		if (p_record->channel >= channels)
+			channels = p_record->channel + 1;
+		// 32 bit cycle counter wraps around, records are in order of time
+		if (position != first)
+			cycles += (uint32_t)(p_record->time - last_time);
+		last_time = p_record->time;
+		time_ns = cycles * 1000000000ull / OW_TRACE_CLOCK_HZ;
+
+		switch (p_record->event)
+		{
+		case OW_TRACE_RESET:
+		case OW_TRACE_WRITE0:
+		case OW_TRACE_SLOT1:
+			change_add(time_ns, p_record->channel, 'd', 0);
+			change_add(time_ns + (uint64_t)p_record->edge * 1000000000ull / OW_TRACE_EDGE_HZ,
+				p_record->channel, 'd', 1);
+			break;
+
+		case OW_TRACE_OP:
+			snprintf(text, sizeof(text), "dq%u %s", p_record->channel,
+				(p_record->edge < (sizeof(op_names) / sizeof(op_names[0]))) ? op_names[p_record->edge] : "?");
+			change_add(time_ns, p_record->channel, 0, 0)->p_text = strdup(text);
+			break;
+
+		case OW_TRACE_DONE:
+		case OW_TRACE_FAIL:
+			snprintf(text, sizeof(text), "dq%u %s, result %u", p_record->channel,
+				(p_record->event == OW_TRACE_DONE) ? "done" : "failed", p_record->edge);
+			change_add(time_ns, p_record->channel, 0, 0)->p_text = strdup(text);
+			if (p_record->event == OW_TRACE_FAIL)
+			{
+				change_add(time_ns, p_record->channel, 'e', 1);
+				change_add(time_ns + ERR_PULSE_NS, p_record->channel, 'e', 0);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+	qsort(m_changes, m_change_count, sizeof(change_t), change_compare);
+
+	printf("$comment ow_trace: %u records, %u lost $end\n", header.head - first, first);
+	printf("$timescale 1 ns $end\n$scope module ow $end\n");
+	for (uint8_t channel = 0; channel < channels; ++channel)
+	{
+		printf("$var wire 1 %c dq%u $end\n", 'a' + channel, channel);
+		printf("$var wire 1 %c err%u $end\n", 'A' + channel, channel);
+	}
+	printf("$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+	for (uint8_t channel = 0; channel < channels; ++channel)
+		printf("1%c\n0%c\n", 'a' + channel, 'A' + channel);
+	printf("$end\n");
+
+	for (uint32_t k = 0; k < m_change_count; ++k)
+	{
+		const change_t* p_change = &m_changes[k];
+
+		if (p_change->time_ns != last_ns)
+		{
+			last_ns = p_change->time_ns;
+			printf("#%llu\n", (unsigned long long)last_ns);
+		}
+		if (p_change->p_text != NULL)
+			printf("$comment %s $end\n", p_change->p_text);
+		else
+			printf("%u%c\n", p_change->value, signal_id(p_change));
+	}
+	return 0;
+}